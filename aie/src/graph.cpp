@@ -26,12 +26,31 @@
 
 using namespace adf;
 
+#ifdef LONG_MODE
+long_graph aie_graph;
+#elif NUM_PARTITIONS == 2
+// Separate top-level graphs, so the host can control each on its own
+my_graph partition_0(0);
+my_graph partition_1(1);
+#elif NUM_PARTITIONS == 1
 my_graph aie_graph;
+#else
+#error "graph.cpp instantiates one or two partitions"
+#endif
 
 int main(int argc, char ** argv)
 {
+#if !defined(LONG_MODE) && NUM_PARTITIONS == 2
+	partition_0.init();
+	partition_1.init();
+	partition_0.run(1);
+	partition_1.run(1);
+	partition_0.end();
+	partition_1.end();
+#else
 	aie_graph.init();
 	aie_graph.run(1);
 	aie_graph.end();
+#endif
 	return 0;
 }
@@ -25,38 +25,46 @@
 #pragma once
 #include <adf.h>
 #include "sw_aie.h"
+#include "sw_long.h"
+#include "common.h"
 
 #define NUM_TILES 8
 
 using namespace adf;
 
+// One partition of the tiles; unless the build is partitioned (see
+// NUM_PARTITIONS) that is all of them, with unprefixed PLIO names
 class my_graph: public graph
 {
 
 private:
 	// ------kernel declaration------
-	kernel sw_aie[NUM_TILES];
+	kernel sw_aie[PARTITION_TILES];
 
 public:
 	// ------Input and Output PLIO declaration------
-	input_plio in_target[NUM_TILES];
-	input_plio in_database[NUM_TILES];
-	output_plio out[NUM_TILES];
+	input_plio in_target[PARTITION_TILES];
+	input_plio in_database[PARTITION_TILES];
+	output_plio out[PARTITION_TILES];
 
-	my_graph()
+	my_graph(int partition = 0)
 	{
-		for (int i = 0; i < NUM_TILES; i++) {
+		// PLIO names of partition p start with "p<p>_", matching xclbin_partitions.cfg
+		std::string prefix = NUM_PARTITIONS > 1 ? "p" + std::to_string(partition) + "_" : "";
+		std::string data = "data/" + prefix;
+
+		for (int i = 0; i < PARTITION_TILES; i++) {
 			// ------kernel creation------
 			sw_aie[i] = kernel::create(compute_sw);
 
 			// Create PLIOs (optional: or use shared input)
-			std::string in_tr_name  = "in_target_"  + std::to_string(i);
-			std::string in_db_name  = "in_database_"  + std::to_string(i);
-			std::string out_name = "out_" + std::to_string(i);
+			std::string in_tr_name  = prefix + "in_target_"  + std::to_string(i);
+			std::string in_db_name  = prefix + "in_database_"  + std::to_string(i);
+			std::string out_name = prefix + "out_" + std::to_string(i);
 
-			in_target[i] = input_plio::create(in_tr_name, plio_32_bits, "data/input" + std::to_string(i) + ".txt");
-			in_database[i] = input_plio::create(in_db_name, plio_32_bits, "data/input" + std::to_string(i) + ".txt");
-			out[i] = output_plio::create(out_name, plio_32_bits, "data/output" + std::to_string(i) + ".txt");
+			in_target[i] = input_plio::create(in_tr_name, plio_32_bits, data + "input" + std::to_string(i) + ".txt");
+			in_database[i] = input_plio::create(in_db_name, plio_32_bits, data + "input" + std::to_string(i) + ".txt");
+			out[i] = output_plio::create(out_name, plio_32_bits, data + "output" + std::to_string(i) + ".txt");
 
 			// ------kernel connection------
 			// it is possible to have stream or window. This is just an example. Try both to see the difference
@@ -75,3 +83,54 @@ public:
 	};
 
 };
+
+// Long-read mode: one alignment at a time, its DP matrix split in column
+// stripes over a chain of LONG_NUM_TILES kernels linked by cascade streams
+class long_graph: public graph
+{
+
+private:
+	// ------kernel declaration------
+	kernel sw_long[LONG_NUM_TILES];
+
+public:
+	// ------Input and Output PLIO declaration------
+	input_plio in_target;
+	input_plio in_database;
+	output_plio out;
+
+	long_graph()
+	{
+		// ------kernel creation------
+		sw_long[0] = kernel::create(compute_sw_long_head);
+		for (int i = 1; i < LONG_NUM_TILES - 1; i++) {
+			sw_long[i] = kernel::create(compute_sw_long_body);
+		}
+		sw_long[LONG_NUM_TILES - 1] = kernel::create(compute_sw_long_tail);
+
+		in_target = input_plio::create("in_long_target", plio_128_bits, "data/in_long_target.txt");
+		in_database = input_plio::create("in_long_database", plio_128_bits, "data/in_long_database.txt");
+		out = output_plio::create("out_long", plio_32_bits, "data/out_long.txt");
+
+		// ------kernel connection------
+		connect<stream>(in_target.out[0], sw_long[0].in[0]);
+		connect<stream>(in_database.out[0], sw_long[0].in[1]);
+
+		for (int i = 0; i < LONG_NUM_TILES - 1; i++) {
+			// database stripes are forwarded down the chain, boundary columns over cascade
+			connect<stream>(sw_long[i].out[0], sw_long[i + 1].in[1]);
+			connect<cascade>(sw_long[i].out[1], sw_long[i + 1].in[0]);
+		}
+
+		connect<stream>(sw_long[LONG_NUM_TILES - 1].out[0], out.in[0]);
+
+		for (int i = 0; i < LONG_NUM_TILES; i++) {
+			// set kernel source and headers
+			source(sw_long[i]) = "src/sw_long.cpp";
+			headers(sw_long[i]) = {"src/sw_long.h","../common/common.h"};
+
+			runtime<ratio>(sw_long[i]) = 0.9;
+		}
+	};
+
+};
@@ -28,6 +28,16 @@
 #include "aie_api/aie_adf.hpp"
 #include "aie_api/utils.hpp"
 
+// Profiling build: cycle stamps around the input, DP and output phases of
+// every pair. Input time is the first pair's read, as later pairs stream in
+// during the DP, where waiting on a slow PLIO feed adds to the DP time;
+// output time includes waiting on output_sink.
+#ifdef PROFILE_AIE
+#define PROFILE_MARK(t) const uint64_t t = tile.cycles()
+#else
+#define PROFILE_MARK(t)
+#endif
+
 void compute_sw(input_stream<int32_t>* restrict in_target, input_stream<int32_t>* restrict in_database, 
     output_stream<int32_t>* restrict output) {
 
@@ -35,24 +45,52 @@ void compute_sw(input_stream<int32_t>* restrict in_target, input_stream<int32_t>
     constexpr int32_t mismatch = MISMATCH;
     constexpr int32_t gap_opening = GAP_OPENING;
 
-    for(int iter=0; iter < INPUT_SIZE / NUM_TILES; iter++) {
+#ifdef PROFILE_AIE
+    aie::tile tile = aie::tile::current();
+    uint64_t input_cycles = 0, compute_cycles = 0, output_cycles = 0;
+    uint32_t max_input_cycles = 0;
+#endif
+
+    // Ping-pong input: pair k + 1 streams into the other buffers, one vector
+    // per stream on each of the first prefetch_rows rows of pair k's DP, so
+    // the PLIO feed runs under the compute instead of between pairs
+    constexpr int num_iter = INPUT_SIZE / PARTITION_TILES;
+    constexpr int prefetch_rows = MAX_DIM / 4;
+    static_assert(MAX_DIM % 4 == 0 && prefetch_rows <= SEQ_SIZE, "a pair must stream in within one DP");
+    alignas(32) int32_t target_buffer[2][MAX_DIM];
+    alignas(32) int32_t database_buffer[2][MAX_DIM];
 
-		int32_t target[MAX_DIM] = {0};
-		int32_t database[MAX_DIM] = {0};
+    for(int iter=0; iter < num_iter; iter++) {
+
+        int32_t* target = target_buffer[iter & 1];
+        int32_t* database = database_buffer[iter & 1];
+        int32_t* next_target = target_buffer[(iter + 1) & 1];
+        int32_t* next_database = database_buffer[(iter + 1) & 1];
+        const bool prefetch = iter + 1 < num_iter;
         alignas(32) int32_t prev_row[SEQ_SIZE+1] = {0};
         alignas(32) int32_t curr_row[SEQ_SIZE+1] = {0};
 
         int32_t score = 0;
 
-        for (int i = 0; i < MAX_DIM; i += 4) {
-            aie::vector<int32_t, 4> tr_vec = readincr_v4(in_target);
-            aie::vector<int32_t, 4> db_vec = readincr_v4(in_database);
+        PROFILE_MARK(t_input);
+        // Only the first pair is read up front, the others came in during the previous DP
+        if (iter == 0) {
+            for (int i = 0; i < MAX_DIM; i += 4) {
+                aie::vector<int32_t, 4> tr_vec = readincr_v4(in_target);
+                aie::vector<int32_t, 4> db_vec = readincr_v4(in_database);
 
-			aie::store_v(target + i, tr_vec);
-			aie::store_v(database + i, db_vec);
+                aie::store_v(target + i, tr_vec);
+                aie::store_v(database + i, db_vec);
+            }
         }
+        PROFILE_MARK(t_compute);
 
 		for (int i = 1; i <= SEQ_SIZE; ++i) {
+			if (prefetch && i <= prefetch_rows) {
+				aie::store_v(next_target + 4 * (i - 1), readincr_v4(in_target));
+				aie::store_v(next_database + 4 * (i - 1), readincr_v4(in_database));
+			}
+
 			for (int j = 1; j <= SEQ_SIZE; ++j) {
 				int m = (target[i - 1] == database[j - 1]) ? MATCH : MISMATCH;
 
@@ -70,6 +108,27 @@ void compute_sw(input_stream<int32_t>* restrict in_target, input_stream<int32_t>
             }
 		}
 
+        PROFILE_MARK(t_output);
         writeincr(output, score);
+        PROFILE_MARK(t_done);
+
+#ifdef PROFILE_AIE
+        input_cycles += t_compute - t_input;
+        compute_cycles += t_output - t_compute;
+        output_cycles += t_done - t_output;
+        max_input_cycles = std::max<uint32_t>(max_input_cycles, t_compute - t_input);
+#endif
     }
+
+#ifdef PROFILE_AIE
+    // PROFILE_WORDS words, decoded by the host (common/profile.h)
+    writeincr(output, INPUT_SIZE / PARTITION_TILES);
+    writeincr(output, (int32_t)input_cycles);
+    writeincr(output, (int32_t)(input_cycles >> 32));
+    writeincr(output, (int32_t)compute_cycles);
+    writeincr(output, (int32_t)(compute_cycles >> 32));
+    writeincr(output, (int32_t)output_cycles);
+    writeincr(output, (int32_t)(output_cycles >> 32));
+    writeincr(output, (int32_t)max_input_cycles);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,178 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "sw_long.h"
+#include "common.h"
+#include "aie_api/aie.hpp"
+#include "aie_api/aie_adf.hpp"
+#include "aie_api/utils.hpp"
+
+// Every tile of the chain owns LONG_STRIPE columns of the DP matrix. Rows are
+// processed in groups of 4: each cascade word carries the 4 target bases
+// (lanes 0-3) and the H values of the stripe's last column (lanes 4-7), which
+// are the left boundary of the next stripe. After the last row one more word
+// carries the running maximum in lane 0.
+//
+// The database stream starts with a header beat holding the number of stripes
+// still to be served; each tile keeps the first stripe and forwards the rest.
+
+static inline void load_stripe(input_stream<int32_t>* restrict in_database,
+    output_stream<int32_t>* restrict out_database, int32_t* restrict database) {
+
+    aie::vector<int32_t, 4> header = readincr_v4(in_database);
+    int32_t stripes = header[0];
+
+    for (int j = 0; j < LONG_STRIPE; j += 4) {
+        aie::vector<int32_t, 4> db_vec = readincr_v4(in_database);
+        aie::store_v(database + j, db_vec);
+    }
+
+    if (out_database != nullptr) {
+        header[0] = stripes - 1;
+        writeincr_v4(out_database, header);
+        for (int j = 0; j < (stripes - 1) * LONG_STRIPE; j += 4) {
+            writeincr_v4(out_database, readincr_v4(in_database));
+        }
+    }
+}
+
+// Computes one row of the stripe in place and returns H on its last column
+static inline int32_t stripe_row(int32_t base, int32_t h_left, int32_t h_diag,
+    const int32_t* restrict database, int32_t* restrict row, int32_t& score) {
+
+    int32_t diag = h_diag;
+    int32_t left = h_left;
+
+    for (int j = 0; j < LONG_STRIPE; ++j)
+    chess_prepare_for_pipelining
+    {
+        int32_t up = row[j];
+        int m = (base == database[j]) ? MATCH : MISMATCH;
+
+        int32_t h = std::max({0, diag + m, up + GAP_OPENING, left + GAP_OPENING});
+
+        diag = up;
+        row[j] = h;
+        left = h;
+        score = std::max(score, h);
+    }
+
+    return left;
+}
+
+static inline aie::accum<acc48, 8> pack_stripe_word(aie::vector<int32_t, 4> bases, aie::vector<int32_t, 4> bound) {
+    aie::accum<acc48, 8> word;
+    word.from_vector(aie::concat(bases, bound), 0);
+    return word;
+}
+
+void compute_sw_long_head(input_stream<int32_t>* restrict in_target, input_stream<int32_t>* restrict in_database,
+    output_stream<int32_t>* restrict out_database, output_cascade<acc48>* restrict out_stripe) {
+
+    for (int iter = 0; iter < LONG_INPUT_SIZE; iter++) {
+
+        int32_t database[LONG_STRIPE];
+        alignas(32) int32_t row[LONG_STRIPE] = {0};
+        int32_t score = 0;
+
+        load_stripe(in_database, out_database, database);
+
+        for (int i = 0; i < LONG_SEQ_SIZE; i += 4) {
+            aie::vector<int32_t, 4> tr_vec = readincr_v4(in_target);
+            aie::vector<int32_t, 4> bound;
+
+            // First stripe: the left boundary is the zero column
+            for (int r = 0; r < 4; ++r) {
+                bound[r] = stripe_row(tr_vec[r], 0, 0, database, row, score);
+            }
+
+            writeincr(out_stripe, pack_stripe_word(tr_vec, bound));
+        }
+
+        aie::vector<int32_t, 4> last = aie::zeros<int32_t, 4>();
+        last[0] = score;
+        writeincr(out_stripe, pack_stripe_word(last, aie::zeros<int32_t, 4>()));
+    }
+}
+
+void compute_sw_long_body(input_cascade<acc48>* restrict in_stripe, input_stream<int32_t>* restrict in_database,
+    output_stream<int32_t>* restrict out_database, output_cascade<acc48>* restrict out_stripe) {
+
+    for (int iter = 0; iter < LONG_INPUT_SIZE; iter++) {
+
+        int32_t database[LONG_STRIPE];
+        alignas(32) int32_t row[LONG_STRIPE] = {0};
+        int32_t score = 0;
+        int32_t h_diag = 0;
+
+        load_stripe(in_database, out_database, database);
+
+        for (int i = 0; i < LONG_SEQ_SIZE; i += 4) {
+            aie::vector<int32_t, 8> word = readincr_v<8>(in_stripe).to_vector<int32_t>(0);
+            aie::vector<int32_t, 4> tr_vec = word.extract<4>(0);
+            aie::vector<int32_t, 4> left = word.extract<4>(1);
+            aie::vector<int32_t, 4> bound;
+
+            for (int r = 0; r < 4; ++r) {
+                bound[r] = stripe_row(tr_vec[r], left[r], h_diag, database, row, score);
+                h_diag = left[r];
+            }
+
+            writeincr(out_stripe, pack_stripe_word(tr_vec, bound));
+        }
+
+        aie::vector<int32_t, 8> last = readincr_v<8>(in_stripe).to_vector<int32_t>(0);
+        aie::vector<int32_t, 4> carry = aie::zeros<int32_t, 4>();
+        carry[0] = std::max(score, (int32_t)last[0]);
+        writeincr(out_stripe, pack_stripe_word(carry, aie::zeros<int32_t, 4>()));
+    }
+}
+
+void compute_sw_long_tail(input_cascade<acc48>* restrict in_stripe, input_stream<int32_t>* restrict in_database,
+    output_stream<int32_t>* restrict output) {
+
+    for (int iter = 0; iter < LONG_INPUT_SIZE; iter++) {
+
+        int32_t database[LONG_STRIPE];
+        alignas(32) int32_t row[LONG_STRIPE] = {0};
+        int32_t score = 0;
+        int32_t h_diag = 0;
+
+        load_stripe(in_database, nullptr, database);
+
+        for (int i = 0; i < LONG_SEQ_SIZE; i += 4) {
+            aie::vector<int32_t, 8> word = readincr_v<8>(in_stripe).to_vector<int32_t>(0);
+            aie::vector<int32_t, 4> tr_vec = word.extract<4>(0);
+            aie::vector<int32_t, 4> left = word.extract<4>(1);
+
+            for (int r = 0; r < 4; ++r) {
+                stripe_row(tr_vec[r], left[r], h_diag, database, row, score);
+                h_diag = left[r];
+            }
+        }
+
+        aie::vector<int32_t, 8> last = readincr_v<8>(in_stripe).to_vector<int32_t>(0);
+        writeincr(output, std::max(score, (int32_t)last[0]));
+    }
+}
@@ -0,0 +1,11 @@
+#pragma once
+#include <adf.h>
+
+void compute_sw_long_head(input_stream<int32_t>* restrict in_target, input_stream<int32_t>* restrict in_database,
+    output_stream<int32_t>* restrict out_database, output_cascade<acc48>* restrict out_stripe);
+
+void compute_sw_long_body(input_cascade<acc48>* restrict in_stripe, input_stream<int32_t>* restrict in_database,
+    output_stream<int32_t>* restrict out_database, output_cascade<acc48>* restrict out_stripe);
+
+void compute_sw_long_tail(input_cascade<acc48>* restrict in_stripe, input_stream<int32_t>* restrict in_database,
+    output_stream<int32_t>* restrict output);
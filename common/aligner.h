@@ -0,0 +1,87 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef ALIGNER_H
+#define ALIGNER_H
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include "../common/backend.h"
+
+namespace swaie {
+    typedef std::function<void(Scores, std::exception_ptr)> Callback;
+
+    // Owns one backend and a worker thread that drains a bounded job queue.
+    // submit() is safe to call from any number of producer threads. Queued
+    // jobs are coalesced up to the backend's preferred_batch() before each
+    // call, so many small submissions still fill whole device runs. With a
+    // non-zero linger the worker waits up to that long for more jobs before
+    // launching a partially filled run.
+    class Aligner {
+    public:
+        explicit Aligner(std::unique_ptr<Backend> backend, size_t max_queued = 64,
+            std::chrono::microseconds linger = std::chrono::microseconds(0));
+        ~Aligner();
+
+        Aligner(const Aligner&) = delete;
+        Aligner& operator=(const Aligner&) = delete;
+
+        std::future<Scores> submit(Batch batch);
+        // The callback runs on the worker thread and must neither throw nor block for long
+        void submit(Batch batch, Callback callback);
+
+        // Blocks until every job submitted so far has completed
+        void drain();
+
+        const Backend& backend() const { return *backend_; }
+
+    private:
+        struct Job {
+            Batch batch;
+            Callback callback;
+        };
+
+        void worker();
+
+        std::unique_ptr<Backend> backend_;
+        size_t max_queued_;
+        std::chrono::microseconds linger_;
+        std::deque<Job> queue_;
+        size_t in_flight_ = 0;
+        bool stopping_ = false;
+        std::mutex mutex_;
+        std::condition_variable not_empty_;
+        std::condition_variable not_full_;
+        std::condition_variable idle_;
+        std::thread worker_;
+    };
+}
+
+#endif // ALIGNER_H
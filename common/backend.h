@@ -0,0 +1,122 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef BACKEND_H
+#define BACKEND_H
+#include <ap_int.h>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../common/common.h"
+#include "../common/sequence_batch.h"
+
+namespace swaie {
+    typedef ap_uint<BITS_PER_CHAR> alphabet_datatype;
+    typedef std::vector<int32_t> Scores;
+
+    // A batch of (target, database) pairs, pair i being target[i] and
+    // database[i]. Sequences are encoded and padded like fastareader does.
+    struct Batch {
+        SequenceBatch target;
+        SequenceBatch database;
+
+        size_t size() const { return target.size(); }
+        // Pairs [first, first + count), sharing this batch's storage
+        Batch slice(size_t first, size_t count) const { return {target.slice(first, count), database.slice(first, count)}; }
+        void append(const Batch& other) {
+            target.append(other.target);
+            database.append(other.database);
+        }
+    };
+
+    class PackFile;
+
+    // Receives count consecutive scores starting at pair first; the
+    // pointer is only valid for the duration of the call
+    typedef std::function<void(size_t first, const int32_t* scores, size_t count)> ScoreSink;
+
+    // An alignment engine. align() is only ever called from one thread at a
+    // time, so implementations may keep per-call state (device buffers, runs).
+    class Backend {
+    public:
+        virtual ~Backend() = default;
+        virtual std::string name() const = 0;
+        // Number of pairs one call handles most efficiently, 0 if any size is fine
+        virtual size_t preferred_batch() const { return 0; }
+        virtual Scores align(const Batch& batch) = 0;
+        // Every pair of a pack file, in file order (see packfile.h)
+        virtual Scores align_packed(const PackFile& pack);
+        // Hands scores to sink in input order as they are ready, which for
+        // the XRT backend is while the kernels are still running
+        virtual void align_streaming(const Batch& batch, const ScoreSink& sink) {
+            Scores scores = align(batch);
+            sink(0, scores.data(), scores.size());
+        }
+    };
+
+    // CPU engines score the first length bases of each sequence, SEQ_SIZE
+    // like the device by default; length 0 takes each batch's longest
+    // sequence, i.e. aligns every pair whole.
+    // Plain compute_golden over every pair
+    std::unique_ptr<Backend> make_cpu_reference_backend(size_t length = SEQ_SIZE);
+    // Inter-pair vectorized DP; threads == 0 uses every hardware thread.
+    // Lengths in KERNEL_LENGTHS run a kernel compiled for them.
+    std::unique_ptr<Backend> make_cpu_simd_backend(unsigned threads = 0, size_t length = SEQ_SIZE);
+    // cpu-simd on 8-bit saturating lanes, twice the pairs per vector; reads
+    // over BYTE_MAX_LENGTH bases run on the 16-bit kernels
+    std::unique_ptr<Backend> make_cpu_simd8_backend(unsigned threads = 0, size_t length = SEQ_SIZE);
+    // One pair at a time, pairs sorted so that databases sharing a prefix
+    // against the same target reuse its DP rows: for amplicon or
+    // duplicate-heavy sets, where the lane engines recompute them per pair
+    std::unique_ptr<Backend> make_cpu_trie_backend(unsigned threads = 0, size_t length = SEQ_SIZE);
+    // One pair at a time, striped down the vector within the pair: for long
+    // reads, where each pair is a large matrix. length 0 aligns the whole of
+    // every sequence.
+    std::unique_ptr<Backend> make_cpu_striped_backend(unsigned threads = 0, size_t length = 0);
+    // Where the XRT backend keeps the host side of its device buffers. Either
+    // way pairs are packed, and scores read, in place with no staging copy.
+    enum class HostMemory {
+        Mapped,     // buffers allocated by XRT, accessed through bo.map()
+        HugePages,  // hugepage user-pointer buffers on the card's NUMA node
+    };
+    // data_reader/output_sink on an accelerator card; loads the xclbin once.
+    // Threads calling align() are pinned to the card's NUMA node, if known.
+    // A partitioned build (NUM_PARTITIONS > 1) shards over the partitions.
+    std::unique_ptr<Backend> make_xrt_backend(const std::string& xclbin_file, unsigned device_id,
+        HostMemory memory = HostMemory::Mapped);
+    // One backend per partition of the card, NUM_PARTITIONS of them, each
+    // with its own kernels and buffers, so they can run separate jobs at once
+    std::vector<std::unique_ptr<Backend>> make_xrt_partition_backends(const std::string& xclbin_file, unsigned device_id,
+        HostMemory memory = HostMemory::Mapped);
+    // One XRT backend per listed card, sharded (see sharded.h) when there are several
+    std::unique_ptr<Backend> make_xrt_backend(const std::string& xclbin_file, const std::vector<unsigned>& device_ids,
+        HostMemory memory = HostMemory::Mapped);
+    // Cards visible to XRT
+    unsigned xrt_device_count();
+    // "0,2,3" or "all" (every card XRT reports)
+    std::vector<unsigned> parse_device_list(const std::string& spec);
+}
+
+#endif // BACKEND_H
@@ -0,0 +1,51 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef CLIENT_H
+#define CLIENT_H
+#include <string>
+#include "../common/backend.h"
+
+namespace swaie {
+
+    // Synchronous connection to a running swaied
+    class Client {
+    public:
+        explicit Client(const std::string& socket_path);
+        ~Client();
+
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+
+        // Throws std::runtime_error on a batch check_request rejects,
+        // connection loss or a server-side error
+        Scores align(const Batch& batch);
+
+    private:
+        int fd_ = -1;
+        uint64_t next_id_ = 0;
+    };
+}
+
+#endif // CLIENT_H
@@ -30,13 +30,17 @@
 
 #define PADDING_SIZE (4 - (SEQ_SIZE % 4)) % 4
 #define MAX_DIM (SEQ_SIZE+PADDING_SIZE)
+// Pad codes past the end of a short target and database; they differ, so
+// pad against pad scores as a mismatch and a padded pair keeps its score
+#define TARGET_PAD 4
+#define DATABASE_PAD 5
 #define DEPTH_STREAM MAX_DIM
-#define NO_COUPLES_PER_STREAM (DEPTH_STREAM/(PACK_SEQ*2))*NUM_TILES
+#define NO_COUPLES_PER_STREAM (DEPTH_STREAM/(PACK_SEQ*2))*PARTITION_TILES
 
 #define BITS_PER_CHAR 4
 #define PORT_WIDTH 512
 #define N_ELEM_BLOCK (PORT_WIDTH/BITS_PER_CHAR)
-#define UNROLL_FACTOR NUM_TILES
+#define UNROLL_FACTOR PARTITION_TILES
 
 #define NUM_TMP_WRITE 512
 
@@ -45,8 +49,64 @@
 
 #define NUM_TILES 8
 
+// Partitioned build (-DNUM_PARTITIONS=2): the tiles are split into
+// independent graphs of PARTITION_TILES, each with its own data_reader and
+// output_sink instance and buffers, so separate runs of INPUT_SIZE couples
+// go through them at the same time. Each reader keeps all its input ports.
+#ifndef NUM_PARTITIONS
+#define NUM_PARTITIONS 1
+#endif
+#define PARTITION_TILES (NUM_TILES/NUM_PARTITIONS)
+
+// Each m_axi input port serves PARTITION_TILES/NUM_INPUT_PORTS tiles: couple
+// i is read from port (i % NUM_INPUT_PORTS), matching the round-robin tile order.
+#define NUM_INPUT_PORTS 4 // data_reader exposes exactly 4 pointer args
+#define TILES_PER_PORT (PARTITION_TILES/NUM_INPUT_PORTS)
+#if PARTITION_TILES % NUM_INPUT_PORTS != 0 || INPUT_SIZE % PARTITION_TILES != 0
+#error "NUM_PARTITIONS must leave every input port and every tile the same share of a run"
+#endif
+#define MAX_READ_BURST 64
+#define NUM_READ_OUTSTANDING 32
+#define MAX_WRITE_BURST 64
+#define NUM_WRITE_OUTSTANDING 16
+#define DEPTH_PORT_STREAM (MAX_READ_BURST*2)
+
 const int m_axi_depth=MAX_DIM*(PACK_SEQ*2+1);
 
+// Profiling build (-DPROFILE_AIE): after its last score every compute_sw
+// tile sends PROFILE_WORDS cycle counters, which output_sink stores after
+// the INPUT_SIZE scores, tile by tile of its partition.
+#define PROFILE_WORDS 8
+#ifdef PROFILE_AIE
+#define PROFILE_TAIL_WORDS (PARTITION_TILES*PROFILE_WORDS)
+#else
+#define PROFILE_TAIL_WORDS 0
+#endif
+#define OUTPUT_WORDS (INPUT_SIZE+PROFILE_TAIL_WORDS)
+
+// output_sink writes the OUTPUT_WORDS of a run as int32 into a ring of
+// RESULT_RING_WORDS slots, publishing how many it has written in a control
+// buffer and waiting on the host's read index before reusing a slot. Must be
+// a power of two and a multiple of NUM_TMP_WRITE.
+#define RESULT_RING_WORDS 4096
+// Control buffer words, each index on its own 64-byte line
+#define RING_WRITE_INDEX 0
+#define RING_READ_INDEX 16
+#define RING_CONTROL_WORDS 32
+
+// Long-read mode: the DP matrix is split in LONG_NUM_TILES column stripes of
+// LONG_STRIPE database bases, chained through cascade streams.
+#define LONG_INPUT_SIZE 64
+#define LONG_SEQ_SIZE 10240
+#define LONG_NUM_TILES 16
+#define LONG_STRIPE (LONG_SEQ_SIZE/LONG_NUM_TILES)
+#define LONG_PACK_SEQ ((LONG_SEQ_SIZE*BITS_PER_CHAR-1)/PORT_WIDTH+1)
+#define LONG_N_PACK (LONG_INPUT_SIZE*(LONG_PACK_SEQ*2))
+#define LONG_TARGET_PAD 4
+#define LONG_DATABASE_PAD 5
+
+const int long_m_axi_depth=LONG_N_PACK;
+
 #define UP 0
 #define UP_LEFT -1
 #define LEFT -1
@@ -0,0 +1,95 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+#ifndef CPU_KERNELS_H
+#define CPU_KERNELS_H
+#include <cstddef>
+#include <cstdint>
+#include "../common/common.h"
+#include "../common/backend.h"
+
+namespace swaie {
+
+    // Linear-gap scores as compile-time constants, so kernels fold them
+    template <int Match, int Mismatch, int Gap>
+    struct LinearScoring {
+        static constexpr int match = Match;
+        static constexpr int mismatch = Mismatch;
+        static constexpr int gap = Gap;
+    };
+    typedef LinearScoring<MATCH, MISMATCH, GAP_OPENING> DeviceScoring;
+
+    // Pairs aligned side by side, one per 16-bit lane
+    const int SIMD_LANES = 32;
+
+    // Read lengths with a kernel compiled for them, as lane_kernel() maps
+    // them; any other runs the generic kernel, which takes the length at
+    // run time
+    const size_t KERNEL_LENGTHS[] = {100, 150, 250, 300};
+
+    // Scores pairs [first, first + count) of batch, count <= SIMD_LANES,
+    // over the first length bases of each sequence. Missing bases never
+    // match, so shorter sequences score as if aligned whole.
+    typedef void (*LaneKernel)(const Batch& batch, size_t first, size_t count, int32_t* scores);
+
+    // The kernel compiled for length, or nullptr when only the generic one
+    // handles it
+    LaneKernel lane_kernel(size_t length);
+    void align_lanes_generic(const Batch& batch, size_t first, size_t count, size_t length, int32_t* scores);
+
+    // Byte lanes: twice the pairs per vector, for reads whose best score
+    // fits 8 bits
+    const int BYTE_LANES = 64;
+    const size_t BYTE_MAX_LENGTH = UINT8_MAX / MATCH;
+
+    // align_lanes_generic on byte lanes, count <= BYTE_LANES and length <=
+    // BYTE_MAX_LENGTH
+    void align_byte_lanes(const Batch& batch, size_t first, size_t count, size_t length, int32_t* scores);
+
+    // Prefix sharing (cpu-trie): scores pairs order[0, count), which are
+    // sorted by target then database, with the DP rows running over the
+    // database bases. A pair with the same target as the one before it
+    // starts from the row where its database leaves the previous one, so a
+    // shared prefix is aligned once. scores is indexed by pair; returns
+    // the DP cells computed.
+    uint64_t align_prefix_sharing(const Batch& batch, const uint32_t* order, size_t count, size_t length, int32_t* scores);
+
+    // Orders a before b by their first length bases, as align_prefix_sharing
+    // needs targets and databases sorted
+    int compare_prefix(SequenceView a, SequenceView b, size_t length);
+
+    // Striped (cpu-striped): one pair at a time, for reads of any length.
+    // The target is laid down the vector lanes in segments with a score
+    // profile per base, the database streams through them, and gaps along
+    // the target are fixed up lazily after each column (Farrar). Runs on
+    // 8-bit cells first and again on 16-bit ones when those saturate.
+    // Bases past length are ignored; lengths whose best score can overflow
+    // 16 bits throw.
+    int32_t align_striped(SequenceView target, SequenceView database, size_t length);
+    const size_t STRIPED_MAX_LENGTH = (UINT16_MAX - (MATCH - MISMATCH)) / MATCH - 1;
+
+    // Longest sequence of the batch, target or database
+    size_t longest_sequence(const Batch& batch);
+}
+
+#endif // CPU_KERNELS_H
@@ -0,0 +1,263 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef DATAFLOW_MODEL_H
+#define DATAFLOW_MODEL_H
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../common/common.h"
+#include "../common/backend.h"
+
+// Software model of the device dataflow, data_reader -> compute_sw x tiles
+// -> output_sink -> host ring, for sizing streams and tile counts without
+// the Vitis tools. Every kernel process runs on its own thread against a
+// stand-in for hls::stream that stamps each word with the modeled cycle it
+// was written and read at. A write waits for the read that frees its slot
+// and a read for its write, so the modeled times follow from the cost
+// model alone and do not depend on how the threads get scheduled.
+namespace swaie {
+namespace model {
+
+    class Simulation;
+    class StreamBase;
+
+    // Modeled clock and time split of one dataflow process, in PL cycles
+    struct Process {
+        std::string name;
+        double now = 0;
+        double busy = 0;
+        double stall_in = 0;
+        double stall_out = 0;
+        bool done = false;
+        // Set while blocked on a real wait
+        const StreamBase* blocked_on = nullptr;
+        bool blocked_writing = false;
+    };
+
+    // Charges cycles of work to the calling process
+    void advance(double cycles);
+
+    struct StreamStats {
+        std::string name;
+        size_t depth = 0;
+        size_t words = 0;
+        double mean_occupancy = 0;
+        size_t max_occupancy = 0;
+        double full_fraction = 0;
+        // Mean cycles a word spends in the stream; mean_occupancy is this
+        // times the word rate (Little's law)
+        double mean_residence = 0;
+        double write_stall = 0;
+        double read_stall = 0;
+    };
+
+    // Untyped half of stream<T>: timestamps, blocking and statistics
+    class StreamBase {
+    public:
+        StreamBase(Simulation& sim, std::string name, size_t depth, double latency);
+        StreamBase(const StreamBase&) = delete;
+        StreamBase& operator=(const StreamBase&) = delete;
+
+        const std::string& name() const { return name_; }
+        size_t size() const;
+        bool empty() const { return size() == 0; }
+        bool full() const { return size() >= depth_; }
+
+        // Over modeled cycles [0, end)
+        StreamStats stats(double end) const;
+
+    protected:
+        friend class Simulation;
+
+        // Called with the simulation lock held; block until the next word
+        // can move, then move the calling process's clock to when it does
+        void begin_write(std::unique_lock<std::mutex>& lock);
+        void begin_read(std::unique_lock<std::mutex>& lock);
+        bool ready(bool writing) const;
+        std::mutex& mutex();
+
+        Simulation& sim_;
+        std::string name_;
+        size_t depth_;
+        double latency_;
+        // Cycle each word was written and read at, by word index
+        std::vector<double> written_;
+        std::vector<double> read_;
+        double write_stall_ = 0;
+        double read_stall_ = 0;
+        std::condition_variable readable_;
+        std::condition_variable writable_;
+    };
+
+    // hls::stream<T> for model processes: depth words of buffering, and a
+    // word written at cycle t can be read from t + latency on
+    template <typename T>
+    class stream : public StreamBase {
+    public:
+        stream(Simulation& sim, std::string name, size_t depth, double latency = 1)
+            : StreamBase(sim, std::move(name), depth, latency) {}
+
+        void write(const T& value) {
+            std::unique_lock<std::mutex> lock(mutex());
+            begin_write(lock);
+            data_.push_back(value);
+        }
+
+        T read() {
+            std::unique_lock<std::mutex> lock(mutex());
+            begin_read(lock);
+            T value = data_.front();
+            data_.pop_front();
+            return value;
+        }
+
+    private:
+        std::deque<T> data_;
+    };
+
+    struct StageStats {
+        std::string name;
+        double busy = 0;
+        double stall_in = 0;
+        double stall_out = 0;
+        double finish = 0;
+    };
+
+    // Runs processes on threads until all of them return, or until every
+    // one left is blocked on a stream that will never move: a deadlock,
+    // which unwinds the blocked processes and is reported instead of hanging.
+    class Simulation {
+    public:
+        Simulation() = default;
+        Simulation(const Simulation&) = delete;
+        Simulation& operator=(const Simulation&) = delete;
+
+        void spawn(std::string name, std::function<void()> body);
+        // Returns false on deadlock; deadlock() then names the stuck processes
+        bool run();
+        const std::string& deadlock() const { return deadlock_; }
+
+        std::vector<StageStats> stages() const;
+        std::vector<StreamStats> streams(double end) const;
+        double finish() const;
+
+    private:
+        friend class StreamBase;
+
+        void wait(std::unique_lock<std::mutex>& lock, std::condition_variable& cv, const StreamBase& stream, bool writing);
+        void check_deadlock();
+        void notify_all_streams();
+
+        std::mutex mutex_;
+        std::vector<StreamBase*> streams_;
+        std::deque<Process> processes_;
+        std::vector<std::function<void()>> bodies_;
+        bool deadlocked_ = false;
+        std::string deadlock_;
+    };
+
+    // Cost of each step, in PL cycles unless the name says AIE. The defaults
+    // are estimates; the aie_* ones can be calibrated from a PROFILE=1 run
+    // (compute cycles / pairs, see common/profile.h).
+    struct CostModel {
+        double pl_mhz = 300;
+        double aie_mhz = 1250;
+        // First beat of a port's read stream; later bursts overlap with
+        // NUM_READ_OUTSTANDING requests in flight
+        double axi_read_latency = 64;
+        double axi_read_ii = 1;
+        double fifo_latency = 1;
+        double dispatch_ii = 1;
+        // dispatchToAIE, per packed word of a couple
+        double read_couple_ii = 1;
+        double unpack_ii = 1;
+        // One base per 32-bit PLIO beat on each of the two streams
+        double plio_ii = 1;
+        double plio_latency = 8;
+        double aie_read_v4 = 1;
+        double aie_cell = 4;
+        double aie_row = 48;
+        double aie_write = 1;
+        double collector_ii = 1;
+        // write_score, per score (its loop is not pipelined)
+        double write_score_ii = 3;
+        // Per NUM_TMP_WRITE block: burst setup, then one beat per score
+        double write_burst_latency = 64;
+        double write_beat = 1;
+        // Until the host sees a published block, and per score it takes
+        double host_poll_latency = 3000;
+        double host_word = 0.1;
+
+        double aie_to_pl(double aie_cycles) const { return aie_cycles * pl_mhz / aie_mhz; }
+    };
+
+    struct ModelConfig {
+        size_t pairs = INPUT_SIZE;
+        int tiles = PARTITION_TILES;
+        size_t port_stream_depth = DEPTH_PORT_STREAM;
+        size_t reads_stream_depth = DEPTH_STREAM;
+        size_t score_stream_depth = NO_COUPLES_PER_STREAM;
+        // Stream switch buffering between a PLIO and its tile, in beats
+        size_t plio_depth = 16;
+        size_t ring_words = RESULT_RING_WORDS;
+        CostModel cost;
+    };
+
+    // Sets a ModelConfig field or a CostModel one by name; false if there
+    // is no such parameter
+    bool set_parameter(ModelConfig& config, const std::string& key, double value);
+    // Every parameter with its value, one per line
+    void print_parameters(std::ostream& os, const ModelConfig& config);
+
+    struct ModelReport {
+        // Until the host has read the last score
+        double cycles = 0;
+        std::vector<StageStats> stages;
+        std::vector<StreamStats> streams;
+        // In pair order, as the host reads them from the ring
+        Scores scores;
+        // Empty unless the configuration deadlocked
+        std::string deadlock;
+
+        double seconds(const CostModel& cost) const { return cycles / (cost.pl_mhz * 1e6); }
+    };
+
+    // Models one run over the first config.pairs pairs of batch, which are
+    // really packed, unpacked and aligned, so the scores can be checked
+    ModelReport run_dataflow_model(const ModelConfig& config, const Batch& batch);
+
+    // Per-stage time split, per-stream occupancy and stalls, and totals
+    void print_report(std::ostream& os, const ModelConfig& config, const ModelReport& report);
+}
+}
+
+#endif // DATAFLOW_MODEL_H
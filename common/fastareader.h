@@ -39,6 +39,12 @@ namespace fastareader {
         std::vector<std::vector<alphabet_datatype>>, 
         std::vector<std::vector<alphabet_datatype>> 
     > readFastaFile(const std::string& filename);
+    // Reads num_pairs (target, database) records of any length, multi-line
+    // sequences included; records longer than max_len are truncated.
+    std::pair< 
+        std::vector<std::vector<alphabet_datatype>>, 
+        std::vector<std::vector<alphabet_datatype>> 
+    > readLongFastaFile(const std::string& filename, size_t num_pairs, size_t max_len);
     void showProgressBar(int progress, int total);
     alphabet_datatype compression(char letter);
 }
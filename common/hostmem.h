@@ -0,0 +1,68 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef HOSTMEM_H
+#define HOSTMEM_H
+#include <cstddef>
+#include <string>
+
+namespace swaie {
+
+    // NUMA node a PCIe device (domain:bus:dev.fn) hangs off, -1 if the
+    // platform does not say
+    int device_numa_node(const std::string& bdf);
+
+    // Restricts the calling thread to the CPUs of a NUMA node; false if the
+    // node is unknown or the affinity cannot be set
+    bool pin_thread_to_node(int node);
+
+    // Page-aligned host memory meant to back user-pointer device buffers.
+    // With hugepages it tries explicit 2 MiB pages first, then transparent
+    // ones; with a node >= 0 the pages are preferably placed on that node.
+    // The memory is zeroed and already faulted in.
+    class HostBuffer {
+    public:
+        HostBuffer() = default;
+        HostBuffer(size_t bytes, int numa_node, bool hugepages);
+        ~HostBuffer();
+
+        HostBuffer(HostBuffer&& other) noexcept;
+        HostBuffer& operator=(HostBuffer&& other) noexcept;
+        HostBuffer(const HostBuffer&) = delete;
+        HostBuffer& operator=(const HostBuffer&) = delete;
+
+        void* data() const { return data_; }
+        size_t size() const { return size_; }
+        // Backed by explicit hugepages rather than regular or THP pages
+        bool huge() const { return huge_; }
+
+    private:
+        void* data_ = nullptr;
+        size_t size_ = 0;
+        size_t mapped_ = 0;
+        bool huge_ = false;
+    };
+}
+
+#endif // HOSTMEM_H
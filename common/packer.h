@@ -0,0 +1,58 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef PACKER_H
+#define PACKER_H
+#include <ap_int.h>
+#include <vector>
+#include "../common/common.h"
+#include "../common/sequence_batch.h"
+
+namespace swaie {
+    typedef ap_uint<BITS_PER_CHAR> alphabet_datatype;
+    typedef ap_uint<PORT_WIDTH> input_t;
+
+    // Words of one packed couple: target in slots [0, MAX_DIM), database in
+    // [MAX_DIM, 2*MAX_DIM), the remaining slots zero. Missing bases are padded
+    // with TARGET_PAD and DATABASE_PAD.
+    const size_t COUPLE_WORDS = PACK_SEQ * 2;
+
+    // Words needed on each input port for num_couples couples
+    size_t port_words(size_t num_couples);
+
+    void pack_couple(SequenceView target, SequenceView database, input_t* dst);
+
+    // Bases unpack_couple gives per sequence: SEQ_SIZE plus the two pad
+    // bases fastareader adds
+    const size_t UNPACKED_LENGTH = SEQ_SIZE + 2;
+
+    // Inverse of pack_couple; target and database get UNPACKED_LENGTH bases
+    void unpack_couple(const input_t* src, uint8_t* target, uint8_t* database);
+
+    // Couple n goes to ports[n % NUM_INPUT_PORTS] at couple slot n / NUM_INPUT_PORTS
+    void pack_striped(const SequenceBatch& target, const SequenceBatch& database,
+        size_t first, size_t count, input_t* const ports[NUM_INPUT_PORTS]);
+}
+
+#endif // PACKER_H
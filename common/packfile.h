@@ -0,0 +1,147 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef PACKFILE_H
+#define PACKFILE_H
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../common/backend.h"
+#include "../common/packer.h"
+#include "../common/seqreader.h"
+
+namespace swaie {
+
+    // Pack files hold pairs already in the data_reader layout, so a run can
+    // hand the mapped file straight to the device:
+    //
+    //   [header, PACK_ALIGNMENT bytes]
+    //   [payload] per run of INPUT_SIZE pairs, NUM_INPUT_PORTS port images
+    //             as pack_striped lays them out, each padded to PACK_ALIGNMENT
+    //   [index]   one PackIndexEntry per pair
+    //   [names]   per pair "target\0database\0"
+    //
+    // The tail run is zero padded to INPUT_SIZE like the device expects.
+    const uint32_t PACK_VERSION = 1;
+    const size_t PACK_ALIGNMENT = 4096;
+
+    struct PackHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t alignment;
+        // Geometry and encoding the payload was packed for
+        uint32_t seq_size;
+        uint32_t max_dim;
+        uint32_t bits_per_char;
+        uint32_t port_width;
+        uint32_t couple_words;
+        uint32_t input_ports;
+        uint32_t run_pairs;
+        uint32_t reserved;
+        char encoding[32];
+        uint64_t num_pairs;
+        uint64_t num_runs;
+        uint64_t port_stride;
+        uint64_t payload_offset;
+        uint64_t index_offset;
+        uint64_t names_offset;
+        uint64_t names_bytes;
+    };
+
+    struct PackIndexEntry {
+        uint32_t target_len;
+        uint32_t database_len;
+        uint64_t name_offset;
+    };
+
+    // Streams pairs into a new pack file. Pairs are laid out as they come,
+    // a run at a time, so memory stays at one run plus the index.
+    class PackWriter {
+    public:
+        explicit PackWriter(const std::string& path);
+        ~PackWriter();
+
+        PackWriter(const PackWriter&) = delete;
+        PackWriter& operator=(const PackWriter&) = delete;
+
+        // info holds two entries per pair, target first (see read_pairs)
+        void add(const Batch& batch, const std::vector<RecordInfo>& info);
+        // Writes the index and the header; returns the number of pairs
+        size_t finish();
+
+    private:
+        void flush_run();
+
+        std::string path_;
+        int fd_ = -1;
+        PackHeader header_;
+        Batch pending_;
+        std::vector<std::vector<input_t>> image_;
+        std::vector<PackIndexEntry> index_;
+        std::string names_;
+        size_t offset_ = 0;
+    };
+
+    // Packs every pair reader yields into path; returns the number of pairs
+    size_t write_packfile(const std::string& path, SequenceReader& reader);
+
+    // True if path starts with the pack file magic
+    bool is_packfile(const std::string& path);
+
+    // Read side: the file is mmap-ed privately, so the payload streams from
+    // the page cache and port() pointers are PACK_ALIGNMENT aligned, as
+    // user-pointer device buffers need. Throws if the file was packed for
+    // another geometry.
+    class PackFile {
+    public:
+        explicit PackFile(const std::string& path);
+        ~PackFile();
+
+        PackFile(const PackFile&) = delete;
+        PackFile& operator=(const PackFile&) = delete;
+
+        size_t size() const { return header_->num_pairs; }
+        size_t runs() const { return header_->num_runs; }
+        size_t run_pairs(size_t run) const;
+        // Bytes of one port image, a multiple of PACK_ALIGNMENT
+        size_t port_bytes() const { return header_->port_stride; }
+        input_t* port(size_t run, int p) const;
+
+        const PackIndexEntry& entry(size_t pair) const { return index_[pair]; }
+        std::string target_name(size_t pair) const;
+        std::string database_name(size_t pair) const;
+
+        // Unpacks pairs [first, first + count) for engines that take a Batch
+        Batch batch(size_t first, size_t count) const;
+
+    private:
+        char* base_ = nullptr;
+        size_t bytes_ = 0;
+        const PackHeader* header_ = nullptr;
+        const PackIndexEntry* index_ = nullptr;
+        const char* names_ = nullptr;
+    };
+}
+
+#endif // PACKFILE_H
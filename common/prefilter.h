@@ -0,0 +1,54 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef PREFILTER_H
+#define PREFILTER_H
+#include <memory>
+#include <vector>
+#include "../common/backend.h"
+
+namespace swaie {
+
+    // Score reported for a pair the prefilter rejected; real scores are >= 0
+    const int32_t FILTERED_SCORE = -1;
+    // Longest j-mer counted; j-mer codes index a table of 4^j counters
+    const unsigned PREFILTER_MAX_K = 8;
+
+    // Upper bound on compute_golden() from the j-mers (j = 1..k) the two
+    // sequences share, counted with multiplicity. Every maximal run of r
+    // matching columns in an alignment holds r-j+1 shared j-mers and runs
+    // are separated by error columns, so an alignment with M matches and E
+    // errors has M <= Q_j + (E+1)(j-1) for every j. Gaps cost more than
+    // mismatches, so the bound is the best M*MATCH + E*MISMATCH over E, with
+    // M + E also limited by the sequence length.
+    int32_t score_upper_bound(SequenceView target, SequenceView database, unsigned k = 4);
+
+    // Drops pairs whose bound is below min_score before inner sees them;
+    // they come back as FILTERED_SCORE. Bounds are computed on threads
+    // (0 = every hardware thread).
+    std::unique_ptr<Backend> make_prefiltered_backend(std::unique_ptr<Backend> inner, int32_t min_score,
+        unsigned k = 4, unsigned threads = 0);
+}
+
+#endif // PREFILTER_H
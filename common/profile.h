@@ -0,0 +1,59 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef PROFILE_H
+#define PROFILE_H
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include "../common/common.h"
+
+namespace swaie {
+
+    // Counters one compute_sw tile reports in a PROFILE_AIE build. Input
+    // cycles are the first pair's read; the others are prefetched during the
+    // DP, so compute cycles include any wait on the PLIO feed. Output cycles
+    // include waiting on output_sink.
+    struct TileProfile {
+        uint64_t pairs = 0;
+        uint64_t input_cycles = 0;
+        uint64_t compute_cycles = 0;
+        uint64_t output_cycles = 0;
+        uint32_t max_input_cycles = 0;
+
+        uint64_t total_cycles() const { return input_cycles + compute_cycles + output_cycles; }
+        TileProfile& operator+=(const TileProfile& other);
+    };
+
+    // Decodes the PARTITION_TILES * PROFILE_WORDS counters output_sink stores
+    // after the scores; words[i * stride] is counter word i
+    std::vector<TileProfile> decode_profile(const int32_t* words, size_t stride);
+
+    // Per-tile cycles per pair and input stall / compute / output stall
+    // shares, plus which of the three limits the array
+    void print_profile(std::ostream& os, const std::vector<TileProfile>& tiles);
+}
+
+#endif // PROFILE_H
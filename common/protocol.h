@@ -0,0 +1,94 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef PROTOCOL_H
+#define PROTOCOL_H
+#include <cstdint>
+#include <string>
+#include "../common/backend.h"
+
+// Wire format between swaied and its clients, over a local Unix socket.
+// All fields are host-endian: both ends always run on the same machine.
+//
+//   request:  RequestHeader, then num_pairs * 2 * seq_len bytes, one base per
+//             byte, target then database for each pair
+//   response: ResponseHeader, then num_pairs int32 scores on success or
+//             message_bytes of error text otherwise
+//
+// A connection may pipeline any number of requests; responses come back in
+// request order.
+namespace swaie {
+    const uint32_t REQUEST_MAGIC = 0x51415753;  // "SWAQ"
+    const uint32_t RESPONSE_MAGIC = 0x52415753; // "SWAR"
+    const uint16_t PROTOCOL_VERSION = 1;
+
+    enum ResponseStatus : uint32_t {
+        STATUS_OK = 0,
+        STATUS_BAD_REQUEST = 1,
+        STATUS_BACKEND_ERROR = 2,
+    };
+
+    struct RequestHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t flags;
+        uint32_t num_pairs;
+        uint32_t seq_len;
+        uint64_t request_id;
+    };
+
+    struct ResponseHeader {
+        uint32_t magic;
+        uint32_t status;
+        uint32_t num_pairs;
+        uint32_t message_bytes;
+        uint64_t request_id;
+    };
+
+    // Upper bounds on pairs per request, bases per sequence and error text,
+    // keep a bad header from exhausting memory
+    const uint32_t MAX_REQUEST_PAIRS = 1u << 24;
+    const uint32_t MAX_REQUEST_SEQ_LEN = 1u << 16;
+    const uint32_t MAX_MESSAGE_BYTES = 1u << 16;
+
+    bool read_full(int fd, void* data, size_t bytes);
+    bool write_full(int fd, const void* data, size_t bytes);
+
+    // Every sequence of a request has the same length, SEQ_SIZE to MAX_DIM
+    // bases; returns why batch does not fit, or an empty string
+    std::string check_request(const Batch& batch);
+
+    // batch must pass check_request
+    bool send_request(int fd, uint64_t request_id, const Batch& batch);
+    // Returns false when the peer closed the connection or sent garbage;
+    // error is set for requests that parsed but cannot be served, whose
+    // payload is consumed and dropped
+    bool recv_request(int fd, RequestHeader& header, Batch& batch, std::string& error);
+
+    bool send_response(int fd, uint64_t request_id, const Scores& scores);
+    bool send_error(int fd, uint64_t request_id, ResponseStatus status, const std::string& message);
+    bool recv_response(int fd, ResponseHeader& header, Scores& scores, std::string& error);
+}
+
+#endif // PROTOCOL_H
@@ -0,0 +1,152 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../common/backend.h"
+#include "../common/hostmem.h"
+#include "../common/seqreader.h"
+
+namespace swaie {
+
+    // Binary result file: a ResultHeader, then one packed ResultRecord per
+    // pair, in the order they were written. Little endian. num_records is 0
+    // when the output could not be seeked back to (a pipe).
+    const char RESULT_MAGIC[8] = {'S', 'W', 'A', 'I', 'E', 'R', 'S', '\0'};
+    const uint32_t RESULT_VERSION = 1;
+
+    struct ResultHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t record_bytes;
+        uint64_t num_records;
+        uint8_t reserved[40];
+    };
+    static_assert(sizeof(ResultHeader) == 64, "ResultHeader is 64 bytes on disk");
+
+#pragma pack(push, 1)
+    struct ResultRecord {
+        uint64_t pair_id;
+        int32_t score;
+    };
+#pragma pack(pop)
+
+    enum class ResultFormat {
+        Binary,
+        Tsv,        // pair_id, score[, target name, database name]
+    };
+
+    // Tsv for a ".tsv" path, Binary otherwise
+    ResultFormat result_format_for(const std::string& path);
+
+    struct WriterOptions {
+        // Aligned staging buffer the I/O thread fills and writes
+        size_t buffer_bytes = 8 << 20;
+        // Chunks of about buffer_bytes queued ahead of the I/O thread
+        // before write() blocks
+        size_t queued_chunks = 8;
+        // Bypass the page cache (O_DIRECT), if the filesystem allows it
+        bool direct = false;
+    };
+
+    // Persists scores from its own I/O thread. write() only copies the
+    // scores into the current chunk; formatting and writing happen on the
+    // I/O thread, in whole buffer_bytes blocks, so callers only wait when
+    // the disk falls queued_chunks behind. "-" writes to stdout.
+    class ResultWriter {
+    public:
+        struct Stats {
+            uint64_t records = 0;
+            uint64_t bytes = 0;
+            // write() calls that found the queue full, and the time they waited
+            uint64_t stalls = 0;
+            double stall_seconds = 0;
+        };
+
+        ResultWriter(const std::string& path, ResultFormat format, WriterOptions options = WriterOptions());
+        ~ResultWriter();
+
+        ResultWriter(const ResultWriter&) = delete;
+        ResultWriter& operator=(const ResultWriter&) = delete;
+
+        // Scores of pairs first_id, first_id + 1, ...; info, as filled by
+        // SequenceReader::read_pairs with keep_names, adds names to TSV output
+        void write(uint64_t first_id, const Scores& scores, const std::vector<RecordInfo>* info = nullptr);
+        void write(uint64_t first_id, const int32_t* scores, size_t count, const std::vector<RecordInfo>* info = nullptr);
+        // Writes out everything queued and finalizes the file; errors from
+        // the I/O thread are rethrown here or from write()
+        void close();
+
+        // Complete after close()
+        const Stats& stats() const { return stats_; }
+
+    private:
+        struct Chunk {
+            std::vector<ResultRecord> records;
+            // Two per record (target, database) when names are kept
+            std::vector<std::string> names;
+        };
+
+        void push(Chunk chunk);
+        void io_thread();
+        void emit(const char* data, size_t bytes);
+        void flush(bool final);
+        void check();
+
+        std::string path_;
+        ResultFormat format_;
+        WriterOptions options_;
+        int fd_ = -1;
+        bool direct_ = false;
+        bool closed_ = false;
+        bool named_ = false;
+        bool first_write_ = true;
+        size_t chunk_records_;
+        Chunk current_;
+        Stats stats_;
+
+        // I/O thread state
+        HostBuffer buffer_;
+        size_t used_ = 0;
+        uint64_t offset_ = 0;
+
+        std::deque<Chunk> queue_;
+        bool done_ = false;
+        std::exception_ptr error_;
+        std::mutex mutex_;
+        std::condition_variable not_empty_;
+        std::condition_variable not_full_;
+        std::thread thread_;
+    };
+}
+
+#endif // RESULT_WRITER_H
@@ -0,0 +1,93 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef SCORE_CACHE_H
+#define SCORE_CACHE_H
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "../common/backend.h"
+
+namespace swaie {
+
+    // 128-bit fingerprint of a (target, database) pair over the bases the
+    // engines actually score, seeded with the scoring parameters
+    struct PairKey {
+        uint64_t lo;
+        uint64_t hi;
+
+        bool operator==(const PairKey& o) const { return lo == o.lo && hi == o.hi; }
+    };
+
+    PairKey pair_key(SequenceView target, SequenceView database);
+
+    // Fixed-capacity open-addressing table of pair scores. Without a path it
+    // lives on the heap; with one it is an mmap-ed file that survives runs
+    // and is reset if it was written with another geometry or scoring.
+    // Once the table is 3/4 full new keys overwrite their home slot, so it
+    // behaves as a lossy cache rather than failing. Not thread-safe.
+    class ScoreCache {
+    public:
+        struct Stats {
+            uint64_t lookups = 0;
+            uint64_t hits = 0;
+            uint64_t inserts = 0;
+        };
+
+        explicit ScoreCache(size_t capacity, const std::string& path = "");
+        ~ScoreCache();
+
+        ScoreCache(const ScoreCache&) = delete;
+        ScoreCache& operator=(const ScoreCache&) = delete;
+
+        bool lookup(const PairKey& key, int32_t& score);
+        void insert(const PairKey& key, int32_t score);
+
+        size_t size() const;
+        size_t capacity() const { return mask_ + 1; }
+        const Stats& stats() const { return stats_; }
+
+    private:
+        struct Header;
+        struct Entry;
+
+        Header* header_ = nullptr;
+        Entry* entries_ = nullptr;
+        size_t mask_ = 0;
+        size_t mapped_bytes_ = 0;
+        int fd_ = -1;
+        std::vector<uint64_t> heap_;
+        Stats stats_;
+    };
+
+    // Wraps another backend: pairs found in the cache, or repeated inside a
+    // batch, are aligned once and their score fanned back out. Only the
+    // unique misses reach the inner backend, so packing and device runs
+    // shrink with the duplication rate.
+    std::unique_ptr<Backend> make_cached_backend(std::unique_ptr<Backend> inner,
+        size_t capacity = 1 << 22, const std::string& path = "");
+}
+
+#endif // SCORE_CACHE_H
@@ -0,0 +1,124 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef SEQREADER_H
+#define SEQREADER_H
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../common/backend.h"
+
+namespace swaie {
+
+    struct ReaderOptions {
+        // Records are cut at max_len bases (0 keeps them whole)
+        size_t max_len = SEQ_SIZE;
+        // Pad short records to max_len and append the two pad bases
+        // readFastaFile adds, so they feed the short-read engines as is.
+        // Even records (targets) get TARGET_PAD, odd ones DATABASE_PAD.
+        bool fixed_length = true;
+        // BGZF inflate workers, 0 uses every hardware thread
+        unsigned threads = 0;
+        // Decompressed chunks and record batches kept in flight
+        size_t queue_depth = 32;
+        // Keep each record's name (header up to the first blank) for next()
+        bool keep_names = false;
+    };
+
+    struct RecordInfo {
+        std::string name;
+        // Bases in the input, before truncation or padding
+        size_t length = 0;
+    };
+
+    // Streams FASTA or FASTQ records, plain, gzip or BGZF, from a file or
+    // from stdin ("-"). The format is sniffed from the first bytes. BGZF
+    // blocks are inflated in parallel and reassembled in order; parsing and
+    // encoding run on their own thread behind a bounded queue, so reading
+    // overlaps with whatever consumes the records. Errors raised on the
+    // pipeline threads are rethrown from next()/read_pairs().
+    class SequenceReader {
+    public:
+        explicit SequenceReader(const std::string& path, ReaderOptions options = ReaderOptions());
+        ~SequenceReader();
+
+        SequenceReader(const SequenceReader&) = delete;
+        SequenceReader& operator=(const SequenceReader&) = delete;
+
+        // Next encoded record; false at end of input
+        bool next(std::vector<alphabet_datatype>& seq, RecordInfo* info = nullptr);
+        // Appends up to max_pairs (target, database) record pairs to batch
+        // and returns how many were added; 0 at end of input. info, if
+        // given, gets two entries per pair, target first. Sequence ids are
+        // record indices in the input.
+        size_t read_pairs(Batch& batch, size_t max_pairs, std::vector<RecordInfo>* info = nullptr);
+
+        // e.g. "FASTQ (BGZF)"
+        std::string format() const;
+
+    private:
+        template <typename T> class Queue;
+        struct Records {
+            SequenceBatch seqs;
+            std::vector<RecordInfo> info;
+        };
+
+        // The view stays valid until the call after next; id is the record's
+        // index in the input
+        bool next_view(SequenceView& seq, uint64_t& id, RecordInfo* info);
+
+        size_t read_raw(char* dst, size_t bytes);
+        void decode_plain();
+        void decode_gzip();
+        void decode_bgzf();
+        void parse();
+        void fail(std::exception_ptr error);
+
+        int fd_ = -1;
+        std::string pending_;
+        ReaderOptions options_;
+        std::string compression_;
+        std::atomic<char> record_marker_{0};
+
+        std::unique_ptr<Queue<std::future<std::string>>> chunks_;
+        std::unique_ptr<Queue<Records>> records_;
+        std::thread decoder_;
+        std::thread parser_;
+
+        Records current_;
+        Records previous_;
+        size_t current_pos_ = 0;
+
+        std::mutex error_mutex_;
+        std::exception_ptr error_;
+    };
+}
+
+#endif // SEQREADER_H
@@ -0,0 +1,101 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef SEQUENCE_BATCH_H
+#define SEQUENCE_BATCH_H
+#include <ap_int.h>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../common/common.h"
+
+namespace swaie {
+    typedef ap_uint<BITS_PER_CHAR> alphabet_datatype;
+
+    // One encoded sequence, a base code per byte, borrowed from an arena
+    class SequenceView {
+    public:
+        SequenceView() = default;
+        SequenceView(const uint8_t* data, size_t length) : data_(data), length_(length) {}
+
+        size_t size() const { return length_; }
+        bool empty() const { return length_ == 0; }
+        const uint8_t* data() const { return data_; }
+        const uint8_t* begin() const { return data_; }
+        const uint8_t* end() const { return data_ + length_; }
+        uint8_t operator[](size_t i) const { return data_[i]; }
+
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t length_ = 0;
+    };
+
+    // Sequences stored back to back in one byte arena, with an offset,
+    // length and id per sequence. Copies and slices share the storage, so
+    // both are O(1); appending to a batch whose storage is shared, or that
+    // is a slice ending before the storage does, first moves its own
+    // sequences to fresh storage. Ids default to the sequence's index at
+    // the time it was appended.
+    class SequenceBatch {
+    public:
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+        SequenceView operator[](size_t i) const {
+            const Storage& s = *storage_;
+            return SequenceView(s.bases.data() + s.offset[first_ + i], s.length[first_ + i]);
+        }
+        uint64_t id(size_t i) const { return storage_->id[first_ + i]; }
+        // Bases over every sequence of the batch
+        size_t bases() const;
+
+        void reserve(size_t sequences, size_t bases);
+        void push_back(SequenceView seq);
+        void push_back(SequenceView seq, uint64_t id);
+        void push_back(const std::vector<alphabet_datatype>& seq);
+        // Room for a sequence of length bases, to be filled in place
+        uint8_t* append(size_t length, uint64_t id);
+        // Every sequence of other, ids included
+        void append(const SequenceBatch& other);
+        void clear();
+
+        SequenceBatch slice(size_t first, size_t count) const;
+
+    private:
+        struct Storage {
+            std::vector<uint8_t> bases;
+            std::vector<uint64_t> offset;
+            std::vector<uint32_t> length;
+            std::vector<uint64_t> id;
+        };
+
+        // Makes storage_ exclusively ours and ending at our last sequence
+        Storage& own();
+
+        std::shared_ptr<Storage> storage_ = std::make_shared<Storage>();
+        size_t first_ = 0;
+        size_t count_ = 0;
+    };
+}
+
+#endif // SEQUENCE_BATCH_H
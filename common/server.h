@@ -0,0 +1,70 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef SERVER_H
+#define SERVER_H
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../common/aligner.h"
+
+namespace swaie {
+
+    // Accepts clients on a Unix socket and feeds their requests into one
+    // shared Aligner, so the backend (and its loaded xclbin) outlives every
+    // client and concurrent requests coalesce into full runs. With an
+    // express Aligner, requests of up to express_pairs pairs go there
+    // instead, so small latency-bound jobs never queue behind bulk ones.
+    class Server {
+    public:
+        Server(Aligner& aligner, const std::string& socket_path, Aligner* express = nullptr, size_t express_pairs = 0);
+        ~Server();
+
+        Server(const Server&) = delete;
+        Server& operator=(const Server&) = delete;
+
+        // Blocks accepting clients until stop() is called
+        void serve();
+        // Safe to call from any thread or from a signal-driven watcher
+        void stop();
+
+    private:
+        void handle(int fd);
+
+        Aligner& aligner_;
+        Aligner* express_;
+        size_t express_pairs_;
+        std::string socket_path_;
+        int listen_fd_ = -1;
+        std::atomic<bool> stopping_{false};
+        std::mutex mutex_;
+        std::vector<int> client_fds_;
+        std::vector<std::thread> clients_;
+        std::vector<std::thread::id> finished_;
+    };
+}
+
+#endif // SERVER_H
@@ -0,0 +1,60 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef SHARDED_H
+#define SHARDED_H
+#include <memory>
+#include <string>
+#include <vector>
+#include "../common/backend.h"
+
+namespace swaie {
+
+    // Spreads every align() call over several backends, each driven by its
+    // own thread pulling chunks from a shared cursor. A shard's chunk grows
+    // with its measured throughput (moving average of pairs/s) relative to
+    // the fastest shard, rounded up to its preferred_batch(). Near the end
+    // of a batch a shard only takes what it can finish before the others
+    // would be through the rest, so the tail is not stuck behind a slow
+    // device. Scores land at their pairs' offsets, so the result is in
+    // input order.
+    // chunk_pairs == 0 picks the largest preferred_batch(), or 1024.
+    std::unique_ptr<Backend> make_sharded_backend(std::vector<std::unique_ptr<Backend>> shards, size_t chunk_pairs = 0);
+
+    // The devices plus a cpu-simd8 engine as one more shard, so the host's
+    // cores align pairs while the cards run. cpu_threads == 0 leaves a core
+    // per device for packing and draining its results.
+    std::unique_ptr<Backend> make_hybrid_backend(std::vector<std::unique_ptr<Backend>> devices, unsigned cpu_threads = 0);
+
+    // Stand-in for a card when testing scheduling: the score of a pair is
+    // its number of same-position matches over SEQ_SIZE bases, and a call
+    // takes at least pairs / pairs_per_second, pairs rounded up to whole
+    // preferred batches like a card's runs.
+    std::unique_ptr<Backend> make_mock_backend(const std::string& name, double pairs_per_second, size_t preferred_batch = 0);
+
+    // Score the mock backend gives a pair
+    int32_t mock_score(SequenceView target, SequenceView database);
+}
+
+#endif // SHARDED_H
@@ -0,0 +1,77 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#ifndef TRACE_H
+#define TRACE_H
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+// Host-side timeline of execution phases. Spans go to a per-thread ring
+// (single writer, no locks once the thread has one); disabled, a span
+// costs one relaxed load. Dumps as Chrome trace JSON (chrome://tracing,
+// ui.perfetto.dev) and as a per-phase summary with GCUPS for spans that
+// carry a cell count.
+namespace swaie {
+namespace trace {
+
+    extern std::atomic<bool> active;
+
+    inline bool enabled() { return active.load(std::memory_order_relaxed); }
+
+    // Starts recording; each thread keeps its last events_per_thread spans
+    void enable(size_t events_per_thread = 1 << 14);
+
+    // Label for the calling thread's row in the timeline
+    void set_thread_name(const std::string& name);
+
+    uint64_t now_ns();
+
+    // name must outlive the trace (string literals)
+    void record(const char* name, uint64_t start_ns, uint64_t end_ns, uint64_t cells = 0);
+
+    class Span {
+    public:
+        explicit Span(const char* name, uint64_t cells = 0)
+            : name_(name), cells_(cells), start_(enabled() ? now_ns() : 0) {}
+        ~Span() { if (start_) record(name_, start_, now_ns(), cells_); }
+
+        Span(const Span&) = delete;
+        Span& operator=(const Span&) = delete;
+
+    private:
+        const char* name_;
+        uint64_t cells_;
+        uint64_t start_;
+    };
+
+    // Both read every ring; call them once the traced work has finished
+    bool write_chrome_json(const std::string& path);
+    void print_summary(std::ostream& os);
+
+} // namespace trace
+}
+
+#endif // TRACE_H
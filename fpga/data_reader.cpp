@@ -64,40 +64,28 @@ void dispatchToAIE(hls::stream<input_t> &reads_stream,
 	}
 }
 
-void read_input_data(input_t *input, hls::stream<input_t> &input_stream, int n, int num_couples) {
+void read_input_data(input_t *input, hls::stream<input_t> &port_stream, int port_couples) {
 
 #pragma HLS INLINE off
 
-	int iter;
-
-	iter = (num_couples - (n)) < NO_COUPLES_PER_STREAM ?
-			(num_couples - (n)) * (PACK_SEQ << 1) :
-			NO_COUPLES_PER_STREAM * (PACK_SEQ << 1);
-
-	for (int i = 0; i < iter; i++) {
-		input_t tmp = input[n * (PACK_SEQ << 1) + i];
-		input_stream.write(tmp);
+	// One sequential pass over the port: HLS turns it into MAX_READ_BURST-beat
+	// bursts with up to NUM_READ_OUTSTANDING requests in flight.
+	loop_read_input_data: for (int i = 0; i < port_couples * (PACK_SEQ << 1); i++) {
+#pragma HLS PIPELINE II=1
+		port_stream.write(input[i]);
 	}
 }
 
-void read_input_data_wrapper(input_t *input,
-		hls::stream<input_t> &input_stream, int num_couples) {
-
-	loop_read_input_data_wrapper: for (int n = 0; n < num_couples; n += NO_COUPLES_PER_STREAM)
-#pragma HLS PIPELINE off
-		read_input_data(input, input_stream, n, num_couples);
-}
+void dispatcher(hls::stream<input_t> &port_stream, hls::stream<input_t> reads_stream[TILES_PER_PORT],
+		int port_couples) {
 
-void dispatcher(hls::stream<input_t> &input_stream, hls::stream<input_t> reads_stream[NUM_TILES] ,
-		int num_couples) {
-		
 		int idx = 0;
-	loop_dispatcher: for (int i = 0; i < num_couples;
-			i++, idx = idx < (NUM_TILES - 1) ? (idx + 1) : 0) {
- 
+	loop_dispatcher: for (int i = 0; i < port_couples;
+			i++, idx = idx < (TILES_PER_PORT - 1) ? (idx + 1) : 0) {
+
 		loop_dispatcher_inner: for (int j = 0; j < (PACK_SEQ << 1); j++) {
  #pragma HLS PIPELINE
- 			input_t tmp = input_stream.read();
+ 			input_t tmp = port_stream.read();
 			reads_stream[idx].write(tmp);
 		}
 	}
@@ -109,7 +97,7 @@ void compute_wrapper(hls::stream<input_t>& reads_stream,
 		hls::stream<ap_int<sizeof(int32_t) * 8 * 4>>& database_aie, 
 		int num_couples) {
 
-	int num_iter = num_couples / NUM_TILES;
+	int num_iter = num_couples / PARTITION_TILES;
 
 	loop_compute_wrapper: for (int n = 0; n < num_iter; n++) {
 #pragma HLS PIPELINE off
@@ -117,33 +105,52 @@ void compute_wrapper(hls::stream<input_t>& reads_stream,
 	}
 }
 
-void alignment(input_t *input, int num_couples,
-		hls::stream<input_t> &input_stream,
-		hls::stream<input_t> reads_stream[NUM_TILES],
-		hls::stream<ap_int<sizeof(int32_t) * 8 * 4>> target_aie[NUM_TILES], 
-		hls::stream<ap_int<sizeof(int32_t) * 8 * 4>> database_aie[NUM_TILES]) {
+int port_couples(int num_couples, int port) {
+#pragma HLS INLINE
+	return (num_couples - port + NUM_INPUT_PORTS - 1) / NUM_INPUT_PORTS;
+}
+
+void alignment(input_t *input0, input_t *input1, input_t *input2, input_t *input3, int num_couples,
+		hls::stream<input_t> port_stream[NUM_INPUT_PORTS],
+		hls::stream<input_t> reads_stream[NUM_INPUT_PORTS][TILES_PER_PORT],
+		hls::stream<ap_int<sizeof(int32_t) * 8 * 4>> target_aie[PARTITION_TILES], 
+		hls::stream<ap_int<sizeof(int32_t) * 8 * 4>> database_aie[PARTITION_TILES]) {
 
 #pragma HLS INLINE
 
 	int tot_couples = num_couples;
-	read_input_data_wrapper(input, input_stream, tot_couples);
-	dispatcher(input_stream, reads_stream, tot_couples);
-	for (int i = 0; i < NUM_TILES; i++) {
+	read_input_data(input0, port_stream[0], port_couples(tot_couples, 0));
+	read_input_data(input1, port_stream[1], port_couples(tot_couples, 1));
+	read_input_data(input2, port_stream[2], port_couples(tot_couples, 2));
+	read_input_data(input3, port_stream[3], port_couples(tot_couples, 3));
+	for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+#pragma HLS unroll
+		dispatcher(port_stream[p], reads_stream[p], port_couples(tot_couples, p));
+	}
+	// Tile t is fed by port (t % NUM_INPUT_PORTS), slot (t / NUM_INPUT_PORTS)
+	for (int i = 0; i < PARTITION_TILES; i++) {
 #pragma HLS unroll factor=UNROLL_FACTOR
-		 compute_wrapper(reads_stream[i], target_aie[i], database_aie[i], tot_couples);
+		 compute_wrapper(reads_stream[i % NUM_INPUT_PORTS][i / NUM_INPUT_PORTS], target_aie[i], database_aie[i], tot_couples);
 	 }
 }
 
 
 extern "C" {
-    void data_reader(input_t *input, int num_couples, 
-		hls::stream<ap_int<sizeof(int32_t) * 8 * 4>> target_aie[NUM_TILES],
-		hls::stream<ap_int<sizeof(int32_t) * 8 * 4>> database_aie[NUM_TILES]) {
+    void data_reader(input_t *input0, input_t *input1, input_t *input2, input_t *input3, int num_couples, 
+		hls::stream<ap_int<sizeof(int32_t) * 8 * 4>> target_aie[PARTITION_TILES],
+		hls::stream<ap_int<sizeof(int32_t) * 8 * 4>> database_aie[PARTITION_TILES]) {
 #pragma HLS INTERFACE s_axilite port=return bundle=control
 
-#pragma HLS INTERFACE m_axi port=input offset=slave bundle=gmem0 depth=m_axi_depth
+// One bundle per input port, each linked to its own NoC/memory controller
+#pragma HLS INTERFACE m_axi port=input0 offset=slave bundle=gmem0 depth=m_axi_depth max_read_burst_length=MAX_READ_BURST num_read_outstanding=NUM_READ_OUTSTANDING
+#pragma HLS INTERFACE m_axi port=input1 offset=slave bundle=gmem1 depth=m_axi_depth max_read_burst_length=MAX_READ_BURST num_read_outstanding=NUM_READ_OUTSTANDING
+#pragma HLS INTERFACE m_axi port=input2 offset=slave bundle=gmem2 depth=m_axi_depth max_read_burst_length=MAX_READ_BURST num_read_outstanding=NUM_READ_OUTSTANDING
+#pragma HLS INTERFACE m_axi port=input3 offset=slave bundle=gmem3 depth=m_axi_depth max_read_burst_length=MAX_READ_BURST num_read_outstanding=NUM_READ_OUTSTANDING
 
-#pragma HLS INTERFACE s_axilite port=input bundle=control
+#pragma HLS INTERFACE s_axilite port=input0 bundle=control
+#pragma HLS INTERFACE s_axilite port=input1 bundle=control
+#pragma HLS INTERFACE s_axilite port=input2 bundle=control
+#pragma HLS INTERFACE s_axilite port=input3 bundle=control
 #pragma HLS INTERFACE s_axilite port=num_couples bundle=control
 
 // Comunication with AIE
@@ -152,15 +159,15 @@ extern "C" {
 
 #pragma HLS DATAFLOW
 
-	static hls::stream<input_t> input_stream("input_stream");
-#pragma HLS STREAM variable=input_stream depth=NO_COUPLES_PER_STREAM dim=1
+	static hls::stream<input_t> port_stream[NUM_INPUT_PORTS];
+#pragma HLS STREAM variable=port_stream depth=DEPTH_PORT_STREAM dim=1
 
-	static hls::stream<input_t> reads_stream[NUM_TILES];
-#pragma HLS STREAM variable=reads_stream depth=DEPTH_STREAM dim=1
+	static hls::stream<input_t> reads_stream[NUM_INPUT_PORTS][TILES_PER_PORT];
+#pragma HLS STREAM variable=reads_stream depth=DEPTH_STREAM
 #pragma HLS BIND_STORAGE variable=reads_stream type=fifo impl=bram
 
 	int tot_couples = num_couples;
-	alignment(input, tot_couples, input_stream, reads_stream, target_aie, database_aie);
+	alignment(input0, input1, input2, input3, tot_couples, port_stream, reads_stream, target_aie, database_aie);
 
     }
 }
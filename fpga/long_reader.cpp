@@ -0,0 +1,107 @@
+/******************************************
+ *MIT License
+ *
+ *Copyright (c) Carmine Pacilio [2025]
+ *
+ *Permission is hereby granted, free of charge, to any person obtaining a copy
+ *of this software and associated documentation files (the "Software"), to deal
+ *in the Software without restriction, including without limitation the rights
+ *to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ *copies of the Software, and to permit persons to whom the Software is
+ *furnished to do so, subject to the following conditions:
+ *
+ *The above copyright notice and this permission notice shall be included in all
+ *copies or substantial portions of the Software.
+ *
+ *THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ *FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ *AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ *LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ *OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ *SOFTWARE.
+ ******************************************/
+
+
+#include <iostream>
+#include <ap_int.h>
+#include "../common/common.h"
+#include "hls_stream.h"
+
+typedef ap_uint<BITS_PER_CHAR> alphabet_datatype;
+typedef ap_uint<PORT_WIDTH> input_t;
+typedef ap_int<sizeof(int32_t) * 8 * 4> aie_beat_t;
+
+// Packed layout per pair: LONG_PACK_SEQ database words, then LONG_PACK_SEQ
+// target words. The database goes first because the head of the cascade
+// chain loads (and forwards) its stripe before it consumes any target row.
+
+void read_long_input(input_t *input, hls::stream<input_t> &input_stream, int num_pairs) {
+
+#pragma HLS INLINE off
+
+	loop_read_long_input: for (int i = 0; i < num_pairs * (LONG_PACK_SEQ << 1); i++) {
+#pragma HLS PIPELINE II=1
+		input_stream.write(input[i]);
+	}
+}
+
+void unpack_word(input_t word, hls::stream<aie_beat_t> &out) {
+
+#pragma HLS INLINE
+
+	unpack_long_word: for (int j = 0; j < N_ELEM_BLOCK; j += 4) {
+#pragma HLS PIPELINE II=1
+		aie_beat_t beat = 0;
+		for (int l = 0; l < 4; l++) {
+			beat.range(32 * l + BITS_PER_CHAR - 1, 32 * l) = word.range(
+				(j + l + 1) * BITS_PER_CHAR - 1,
+				(j + l) * BITS_PER_CHAR);
+		}
+		out.write(beat);
+	}
+}
+
+void dispatch_long(hls::stream<input_t> &input_stream,
+		hls::stream<aie_beat_t> &target_aie,
+		hls::stream<aie_beat_t> &database_aie, int num_pairs) {
+
+	loop_dispatch_long: for (int n = 0; n < num_pairs; n++) {
+		// header beat: number of stripes left to serve down the chain
+		aie_beat_t header = 0;
+		header.range(31, 0) = LONG_NUM_TILES;
+		database_aie.write(header);
+
+		loop_long_database: for (int i = 0; i < LONG_PACK_SEQ; i++) {
+			unpack_word(input_stream.read(), database_aie);
+		}
+		loop_long_target: for (int i = 0; i < LONG_PACK_SEQ; i++) {
+			unpack_word(input_stream.read(), target_aie);
+		}
+	}
+}
+
+extern "C" {
+    void long_reader(input_t *input, int num_pairs,
+		hls::stream<aie_beat_t> &target_aie,
+		hls::stream<aie_beat_t> &database_aie) {
+#pragma HLS INTERFACE s_axilite port=return bundle=control
+
+#pragma HLS INTERFACE m_axi port=input offset=slave bundle=gmem0 depth=long_m_axi_depth max_read_burst_length=MAX_READ_BURST num_read_outstanding=NUM_READ_OUTSTANDING
+
+#pragma HLS INTERFACE s_axilite port=input bundle=control
+#pragma HLS INTERFACE s_axilite port=num_pairs bundle=control
+
+// Comunication with AIE
+#pragma HLS interface axis port=target_aie
+#pragma HLS interface axis port=database_aie
+
+#pragma HLS DATAFLOW
+
+	static hls::stream<input_t> input_stream("long_input_stream");
+#pragma HLS STREAM variable=input_stream depth=DEPTH_PORT_STREAM dim=1
+
+	read_long_input(input, input_stream, num_pairs);
+	dispatch_long(input_stream, target_aie, database_aie, num_pairs);
+
+    }
+}
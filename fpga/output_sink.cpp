@@ -37,9 +37,11 @@ const unsigned int depth_stream = DEPTH_STREAM;
 const unsigned int no_couples_per_stream = NO_COUPLES_PER_STREAM;
 const unsigned int unroll_f = 2;
 const unsigned int num_pack = (PACK_SEQ << 1) + 1;
+const int ring_depth = RESULT_RING_WORDS;
+const int control_depth = RING_CONTROL_WORDS;
 
-void write_score(hls::stream<int> &final_score_stream, int n,
-    input_t *output, int num_couples, int &to_send) {
+void write_score(hls::stream<int> &final_score_stream, int n, int32_t *output,
+    volatile int32_t *control, int num_words, int ring_words, int &to_send, int &read_index) {
 
 #pragma HLS INLINE off
     static int tmp[NUM_TMP_WRITE];
@@ -47,48 +49,73 @@ void write_score(hls::stream<int> &final_score_stream, int n,
 
     tmp[n & (NUM_TMP_WRITE - 1)] = final_score_stream.read();
 
-    if ((n > 0 && (((n + 1) & (NUM_TMP_WRITE - 1)) == 0)) || n == num_couples - 1) {
+    if ((n > 0 && (((n + 1) & (NUM_TMP_WRITE - 1)) == 0)) || n == num_words - 1) {
         int iter = (to_send >= NUM_TMP_WRITE) ? NUM_TMP_WRITE : to_send;
 
+        // Blocks start on NUM_TMP_WRITE boundaries and never straddle the
+        // ring end; wait until the host has read the slots this one reuses
+        loop_wait_ring: while (n + 1 - read_index > ring_words) {
+            read_index = control[RING_READ_INDEX];
+        }
+
+        int base = (n + 1 - iter) & (ring_words - 1);
         for (int i = 0; i < iter; i++) {
 #pragma HLS pipeline
-            output[n + i + 1 - iter] = tmp[i];
+            output[base + i] = tmp[i];
         }
+        // Same AXI port and ID as the scores, so it lands after them
+        control[RING_WRITE_INDEX] = n + 1;
         to_send -= iter;
     } 
 }
 
-void write_score_wrapper(hls::stream<int> &score_local_stream, int num_couples,
-    input_t *output) {
-    int to_send = num_couples;
+void write_score_wrapper(hls::stream<int> &score_local_stream, int num_words,
+    int32_t *output, volatile int32_t *control, int ring_words) {
+    int to_send = num_words;
+    int read_index = 0;
 
-    loop_write_score_wrapper: for (int n = 0; n < num_couples; n++) {
+    loop_write_score_wrapper: for (int n = 0; n < num_words; n++) {
     #pragma HLS PIPELINE off
-        write_score(score_local_stream, n, output, num_couples, to_send);
+        write_score(score_local_stream, n, output, control, num_words, ring_words, to_send, read_index);
     }
 }
 
-void collector(hls::stream<int32_t> input_stream[NUM_TILES],
+void collector(hls::stream<int32_t> input_stream[PARTITION_TILES],
     hls::stream<int> &final_score_stream, int num_couples) {
 
-    loop_collector: for (int i = 0; i < num_couples / NUM_TILES; i++) {
-		 loop_collector_inner: for (int j = 0; j < NUM_TILES; j++) {
+    loop_collector: for (int i = 0; i < num_couples / PARTITION_TILES; i++) {
+		 loop_collector_inner: for (int j = 0; j < PARTITION_TILES; j++) {
  #pragma HLS PIPELINE
 			int tmp = input_stream[j].read();
 			final_score_stream.write(tmp);
 		 }
 	 }
+
+#ifdef PROFILE_AIE
+	// Each tile's counters follow its last score
+	loop_collector_profile: for (int j = 0; j < PARTITION_TILES; j++) {
+		for (int k = 0; k < PROFILE_WORDS; k++) {
+#pragma HLS PIPELINE
+			final_score_stream.write(input_stream[j].read());
+		}
+	}
+#endif
 }
 
 extern "C" {
     
-    void output_sink(hls::stream<int32_t> input_stream[NUM_TILES], input_t* output, int num_couples){
+    // ring_words <= RESULT_RING_WORDS; the host resets both control indices before each run
+    void output_sink(hls::stream<int32_t> input_stream[PARTITION_TILES], int32_t* output, volatile int32_t* control,
+        int num_couples, int ring_words){
     
 #pragma HLS interface axis port=input_stream
 
-#pragma HLS INTERFACE m_axi port=output depth=m_axi_depth offset=slave bundle=gmem1
+#pragma HLS INTERFACE m_axi port=output depth=ring_depth offset=slave bundle=gmem1 max_write_burst_length=MAX_WRITE_BURST num_write_outstanding=NUM_WRITE_OUTSTANDING
+#pragma HLS INTERFACE m_axi port=control depth=control_depth offset=slave bundle=gmem1
 #pragma HLS INTERFACE s_axilite port=output bundle=control
+#pragma HLS INTERFACE s_axilite port=control bundle=control
 #pragma HLS interface s_axilite port=num_couples bundle=control
+#pragma HLS interface s_axilite port=ring_words bundle=control
 #pragma HLS interface s_axilite port=return bundle=control
 
 #pragma HLS DATAFLOW
@@ -97,7 +124,7 @@ extern "C" {
 #pragma HLS STREAM variable=final_score_stream depth=no_couples_per_stream dim=1
 
         collector(input_stream, final_score_stream, num_couples);
-        write_score_wrapper(final_score_stream, num_couples, output);
+        write_score_wrapper(final_score_stream, num_couples + PROFILE_TAIL_WORDS, output, control, ring_words);
 
     }
 }
@@ -0,0 +1,154 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/aligner.h"
+#include "../common/trace.h"
+#include <stdexcept>
+
+namespace swaie {
+
+    static size_t pairs_of(const std::vector<size_t>& sizes) {
+        size_t total = 0;
+        for (size_t n : sizes) total += n;
+        return total;
+    }
+
+    Aligner::Aligner(std::unique_ptr<Backend> backend, size_t max_queued, std::chrono::microseconds linger)
+        : backend_(std::move(backend)), max_queued_(max_queued ? max_queued : 1), linger_(linger) {
+        worker_ = std::thread(&Aligner::worker, this);
+    }
+
+    Aligner::~Aligner() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        not_empty_.notify_all();
+        not_full_.notify_all();
+        worker_.join();
+    }
+
+    std::future<Scores> Aligner::submit(Batch batch) {
+        auto promise = std::make_shared<std::promise<Scores>>();
+        std::future<Scores> result = promise->get_future();
+
+        submit(std::move(batch), [promise](Scores scores, std::exception_ptr error) {
+            if (error) promise->set_exception(error);
+            else promise->set_value(std::move(scores));
+        });
+
+        return result;
+    }
+
+    void Aligner::submit(Batch batch, Callback callback) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this] { return queue_.size() < max_queued_ || stopping_; });
+        if (stopping_) {
+            lock.unlock();
+            callback({}, std::make_exception_ptr(std::runtime_error("[SWAIE] Aligner is shutting down")));
+            return;
+        }
+        queue_.push_back({std::move(batch), std::move(callback)});
+        in_flight_++;
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+
+    void Aligner::drain() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        idle_.wait(lock, [this] { return in_flight_ == 0; });
+    }
+
+    void Aligner::worker() {
+        const size_t target_pairs = backend_->preferred_batch();
+        trace::set_thread_name("aligner");
+
+        for (;;) {
+            std::vector<Job> jobs;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                not_empty_.wait(lock, [this] { return !queue_.empty() || stopping_; });
+                if (queue_.empty()) return;
+
+                // Coalesce whole jobs while they fit the backend's preferred size
+                size_t pairs = 0;
+                auto deadline = std::chrono::steady_clock::now() + linger_;
+                for (;;) {
+                    do {
+                        pairs += queue_.front().batch.size();
+                        jobs.push_back(std::move(queue_.front()));
+                        queue_.pop_front();
+                    } while (!queue_.empty() && target_pairs != 0 &&
+                        pairs + queue_.front().batch.size() <= target_pairs);
+
+                    if (target_pairs == 0 || pairs >= target_pairs || !queue_.empty() || stopping_) break;
+                    not_full_.notify_all();
+                    if (!not_empty_.wait_until(lock, deadline, [this] { return !queue_.empty() || stopping_; })) break;
+                    if (queue_.empty() || pairs + queue_.front().batch.size() > target_pairs) break;
+                }
+            }
+            not_full_.notify_all();
+
+            std::vector<size_t> sizes;
+            for (const Job& job : jobs) sizes.push_back(job.batch.size());
+
+            Scores scores;
+            std::exception_ptr error;
+            {
+                trace::Span span("align", pairs_of(sizes) * (uint64_t)SEQ_SIZE * SEQ_SIZE);
+                try {
+                    if (jobs.size() == 1) {
+                        scores = backend_->align(jobs[0].batch);
+                    } else {
+                        Batch merged;
+                        for (const Job& job : jobs) merged.append(job.batch);
+                        scores = backend_->align(merged);
+                    }
+                } catch (...) {
+                    error = std::current_exception();
+                }
+            }
+
+            if (!error && scores.size() != pairs_of(sizes)) {
+                error = std::make_exception_ptr(std::runtime_error(
+                    "[SWAIE] Backend " + backend_->name() + " returned a wrong number of scores"));
+            }
+
+            size_t offset = 0;
+            for (size_t j = 0; j < jobs.size(); j++) {
+                Scores part;
+                if (!error) part.assign(scores.begin() + offset, scores.begin() + offset + sizes[j]);
+                offset += sizes[j];
+                jobs[j].callback(std::move(part), error);
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                in_flight_ -= jobs.size();
+            }
+            idle_.notify_all();
+        }
+    }
+
+} // namespace swaie
@@ -0,0 +1,236 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/backend.h"
+#include "../common/golden.h"
+#include "../common/cpu_kernels.h"
+#include "../common/trace.h"
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+namespace swaie {
+
+    class CpuReferenceBackend : public Backend {
+    public:
+        explicit CpuReferenceBackend(size_t length) : length_(length) {}
+
+        std::string name() const override { return "cpu-reference"; }
+
+        Scores align(const Batch& batch) override {
+            size_t length = length_ ? length_ : longest_sequence(batch);
+            trace::Span span("cpu_reference", batch.size() * (uint64_t)length * length);
+            Scores scores(batch.size());
+            for (size_t i = 0; i < batch.size(); i++) {
+                scores[i] = compute_golden(batch.target[i], batch.database[i], length);
+            }
+            return scores;
+        }
+
+    private:
+        size_t length_;
+    };
+
+    class CpuSimdBackend : public Backend {
+    public:
+        CpuSimdBackend(unsigned threads, size_t length, bool bytes)
+            : threads_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())), length_(length), bytes_(bytes) {}
+
+        std::string name() const override { return bytes_ ? "cpu-simd8" : "cpu-simd"; }
+
+        Scores align(const Batch& batch) override {
+            // The kernel is picked once per batch, not per lane group
+            size_t length = length_ ? length_ : longest_sequence(batch);
+            LaneKernel kernel = lane_kernel(length);
+            // Reads too long for 8-bit scores fall back to 16-bit lanes
+            bool bytes = bytes_ && length <= BYTE_MAX_LENGTH;
+            size_t lanes = bytes ? BYTE_LANES : SIMD_LANES;
+            trace::Span span(bytes ? "cpu_simd8" : "cpu_simd", batch.size() * (uint64_t)length * length);
+            Scores scores(batch.size());
+            size_t groups = (batch.size() + lanes - 1) / lanes;
+            unsigned workers = (unsigned)std::min<size_t>(threads_, groups);
+
+            auto run = [&](unsigned w) {
+                for (size_t g = w; g < groups; g += workers) {
+                    size_t first = g * lanes;
+                    size_t count = std::min<size_t>(lanes, batch.size() - first);
+                    if (bytes) align_byte_lanes(batch, first, count, length, scores.data() + first);
+                    else if (kernel) kernel(batch, first, count, scores.data() + first);
+                    else align_lanes_generic(batch, first, count, length, scores.data() + first);
+                }
+            };
+
+            std::vector<std::thread> pool;
+            for (unsigned w = 1; w < workers; w++) pool.emplace_back(run, w);
+            if (workers > 0) run(0);
+            for (std::thread& t : pool) t.join();
+
+            return scores;
+        }
+
+    private:
+        unsigned threads_;
+        size_t length_;
+        bool bytes_;
+    };
+
+    // Pairs per work item of cpu-trie; a shared prefix is recomputed once
+    // per item it spans
+    static const size_t TRIE_ITEM_PAIRS = 512;
+
+    class CpuTrieBackend : public Backend {
+    public:
+        CpuTrieBackend(unsigned threads, size_t length)
+            : threads_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())), length_(length) {}
+
+        ~CpuTrieBackend() override {
+            if (full_cells_ == 0) return;
+            std::cout << "[CPU TRIE] Computed " << cells_ << " of " << full_cells_ << " DP cells, "
+                << 100.0 * (full_cells_ - cells_) / full_cells_ << "% reused from shared prefixes." << std::endl;
+        }
+
+        std::string name() const override { return "cpu-trie"; }
+
+        Scores align(const Batch& batch) override {
+            size_t length = length_ ? length_ : longest_sequence(batch);
+            // Checked here too: the kernel's own check would throw on a worker thread
+            if (length * DeviceScoring::match > (size_t)std::numeric_limits<int16_t>::max()) {
+                throw std::runtime_error("[CPU TRIE] Sequences of " + std::to_string(length) + " bases overflow 16-bit scores");
+            }
+            uint64_t full_cells = 0;
+            for (size_t i = 0; i < batch.size(); i++) {
+                full_cells += std::min(length, batch.target[i].size()) * std::min(length, batch.database[i].size());
+            }
+            trace::Span span("cpu_trie", full_cells);
+
+            // Equal targets end up adjacent, their databases in trie order
+            std::vector<uint32_t> order(batch.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+                int c = compare_prefix(batch.target[a], batch.target[b], length);
+                return c != 0 ? c < 0 : compare_prefix(batch.database[a], batch.database[b], length) < 0;
+            });
+
+            Scores scores(batch.size());
+            size_t items = (batch.size() + TRIE_ITEM_PAIRS - 1) / TRIE_ITEM_PAIRS;
+            unsigned workers = (unsigned)std::min<size_t>(threads_, items);
+            std::atomic<size_t> next(0);
+            std::atomic<uint64_t> cells(0);
+
+            auto run = [&] {
+                for (size_t item; (item = next++) < items;) {
+                    size_t first = item * TRIE_ITEM_PAIRS;
+                    size_t count = std::min(TRIE_ITEM_PAIRS, batch.size() - first);
+                    cells += align_prefix_sharing(batch, order.data() + first, count, length, scores.data());
+                }
+            };
+
+            std::vector<std::thread> pool;
+            for (unsigned w = 1; w < workers; w++) pool.emplace_back(run);
+            if (workers > 0) run();
+            for (std::thread& t : pool) t.join();
+
+            cells_ += cells;
+            full_cells_ += full_cells;
+            return scores;
+        }
+
+    private:
+        unsigned threads_;
+        size_t length_;
+        uint64_t cells_ = 0;
+        uint64_t full_cells_ = 0;
+    };
+
+    class CpuStripedBackend : public Backend {
+    public:
+        CpuStripedBackend(unsigned threads, size_t length)
+            : threads_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())), length_(length) {}
+
+        std::string name() const override { return "cpu-striped"; }
+
+        Scores align(const Batch& batch) override {
+            size_t length = length_ ? length_ : longest_sequence(batch);
+            uint64_t cells = 0;
+            for (size_t i = 0; i < batch.size(); i++) {
+                size_t cols = std::min(length, batch.target[i].size());
+                size_t depth = std::min(length, batch.database[i].size());
+                // Checked here too: the kernel's own check would throw on a worker thread
+                if (std::min(cols, depth) > STRIPED_MAX_LENGTH) {
+                    throw std::runtime_error("[CPU STRIPED] Sequences of " + std::to_string(std::min(cols, depth)) + " bases overflow 16-bit scores");
+                }
+                cells += cols * depth;
+            }
+            trace::Span span("cpu_striped", cells);
+
+            // Pairs are claimed one at a time: with long reads a few of them
+            // can be most of the batch
+            Scores scores(batch.size());
+            unsigned workers = (unsigned)std::min<size_t>(threads_, batch.size());
+            std::atomic<size_t> next(0);
+            auto run = [&] {
+                for (size_t i; (i = next++) < batch.size();) {
+                    scores[i] = align_striped(batch.target[i], batch.database[i], length);
+                }
+            };
+
+            std::vector<std::thread> pool;
+            for (unsigned w = 1; w < workers; w++) pool.emplace_back(run);
+            if (workers > 0) run();
+            for (std::thread& t : pool) t.join();
+
+            return scores;
+        }
+
+    private:
+        unsigned threads_;
+        size_t length_;
+    };
+
+    std::unique_ptr<Backend> make_cpu_reference_backend(size_t length) {
+        return std::make_unique<CpuReferenceBackend>(length);
+    }
+
+    std::unique_ptr<Backend> make_cpu_simd_backend(unsigned threads, size_t length) {
+        return std::make_unique<CpuSimdBackend>(threads, length, false);
+    }
+
+    std::unique_ptr<Backend> make_cpu_simd8_backend(unsigned threads, size_t length) {
+        return std::make_unique<CpuSimdBackend>(threads, length, true);
+    }
+
+    std::unique_ptr<Backend> make_cpu_trie_backend(unsigned threads, size_t length) {
+        return std::make_unique<CpuTrieBackend>(threads, length);
+    }
+
+    std::unique_ptr<Backend> make_cpu_striped_backend(unsigned threads, size_t length) {
+        return std::make_unique<CpuStripedBackend>(threads, length);
+    }
+
+} // namespace swaie
@@ -0,0 +1,373 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/backend.h"
+#include "../common/packer.h"
+#include "../common/packfile.h"
+#include "../common/hostmem.h"
+#include "../common/profile.h"
+#include "../common/trace.h"
+#include "../common/sharded.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include "experimental/xrt_kernel.h"
+#include "experimental/xrt_system.h"
+
+#define arg_reader_input 0 // input0..input3 take args 0..NUM_INPUT_PORTS-1
+#define arg_reader_size NUM_INPUT_PORTS
+
+#define arg_sink_output 1
+#define arg_sink_control 2
+#define arg_sink_size 3
+#define arg_sink_ring 4
+
+namespace swaie {
+
+    // The AIE kernels consume exactly INPUT_SIZE couples per graph iteration,
+    // so every device run is INPUT_SIZE couples; short tails are zero padded.
+    class XrtBackend : public Backend {
+    public:
+        // One partition of a loaded xclbin; the whole device unless it was
+        // built partitioned, in which case each has its own reader and sink
+        XrtBackend(const xrt::device& device, const xrt::uuid& uuid, unsigned device_id, HostMemory memory, int partition)
+            : device_id_(device_id), partition_(partition), device_(device), uuid_(uuid) {
+
+            numa_node_ = device_numa_node(device_.get_info<xrt::info::device::bdf>());
+
+            // Compute units of partition p are <kernel>_<p>, see xclbin_partitions.cfg
+            std::string cu = std::to_string(partition) + "}";
+            data_reader_ = xrt::kernel(device_, uuid_, NUM_PARTITIONS > 1 ? "data_reader:{data_reader_" + cu : "data_reader");
+            output_sink_ = xrt::kernel(device_, uuid_, NUM_PARTITIONS > 1 ? "output_sink:{output_sink_" + cu : "output_sink");
+
+            const size_t port_bytes = port_words(INPUT_SIZE) * sizeof(input_t);
+            const size_t output_bytes = RESULT_RING_WORDS * sizeof(int32_t);
+            xrtMemoryGroup bank_mask = output_sink_.group_id(arg_sink_output);
+            xrtMemoryGroup output_bank = static_cast<xrtMemoryGroup>(ffs(bank_mask) - 1);
+
+            if (memory == HostMemory::HugePages) {
+                for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+                    host_.emplace_back(port_bytes, numa_node_, true);
+                    buffer_reader_.push_back(xrt::bo(device_, host_.back().data(), port_bytes,
+                        data_reader_.group_id(arg_reader_input + p)));
+                }
+                host_.emplace_back(output_bytes, numa_node_, true);
+                buffer_output_ = xrt::bo(device_, host_.back().data(), output_bytes, output_bank);
+            } else {
+                for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+                    buffer_reader_.push_back(xrt::bo(device_, port_bytes, xrt::bo::flags::normal,
+                        data_reader_.group_id(arg_reader_input + p)));
+                }
+                buffer_output_ = xrt::bo(device_, output_bytes, xrt::bo::flags::normal, output_bank);
+            }
+            buffer_control_ = xrt::bo(device_, RING_CONTROL_WORDS * sizeof(int32_t), xrt::bo::flags::normal,
+                output_bank);
+
+            // The packer writes, and scores are read, through these directly
+            for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+                ports_[p] = buffer_reader_[p].map<input_t*>();
+            }
+            output_ = buffer_output_.map<const int32_t*>();
+            control_ = buffer_control_.map<int32_t*>();
+
+            run_data_reader_ = xrt::run(data_reader_);
+            run_output_sink_ = xrt::run(output_sink_);
+
+            for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+                run_data_reader_.set_arg(arg_reader_input + p, buffer_reader_[p]);
+            }
+            run_data_reader_.set_arg(arg_reader_size, INPUT_SIZE);
+            run_output_sink_.set_arg(arg_sink_output, buffer_output_);
+            run_output_sink_.set_arg(arg_sink_control, buffer_control_);
+            run_output_sink_.set_arg(arg_sink_size, INPUT_SIZE);
+            run_output_sink_.set_arg(arg_sink_ring, RESULT_RING_WORDS);
+        }
+
+#ifdef PROFILE_AIE
+        ~XrtBackend() override {
+            std::cout << "[PROFILE] " << name() << ", all runs:" << std::endl;
+            print_profile(std::cout, profile_);
+        }
+#endif
+
+        std::string name() const override {
+            std::string card = "xrt:" + std::to_string(device_id_);
+            return NUM_PARTITIONS > 1 ? card + "." + std::to_string(partition_) : card;
+        }
+
+        size_t preferred_batch() const override { return INPUT_SIZE; }
+
+        Scores align(const Batch& batch) override {
+            Scores scores(batch.size());
+            align_streaming(batch, copy_to(scores));
+            return scores;
+        }
+
+        void align_streaming(const Batch& batch, const ScoreSink& sink) override {
+            pin_caller();
+            for (size_t first = 0; first < batch.size(); first += INPUT_SIZE) {
+                size_t count = std::min<size_t>(INPUT_SIZE, batch.size() - first);
+                pack_chunk(batch, first, count);
+                launch(first, count, sink);
+            }
+        }
+
+        // Zero copy: each port image of the mapped file becomes a user-pointer
+        // buffer, so nothing is parsed or packed and the data comes straight
+        // from the page cache
+        Scores align_packed(const PackFile& pack) override {
+            pin_caller();
+            Scores scores(pack.size());
+            ScoreSink sink = copy_to(scores);
+
+            for (size_t run = 0; run < pack.runs(); run++) {
+                std::vector<xrt::bo> ports;
+                {
+                    trace::Span span("h2d_sync");
+                    for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+                        ports.emplace_back(device_, pack.port(run, p), pack.port_bytes(), data_reader_.group_id(arg_reader_input + p));
+                        ports[p].sync(XCL_BO_SYNC_BO_TO_DEVICE);
+                        run_data_reader_.set_arg(arg_reader_input + p, ports[p]);
+                    }
+                }
+                launch(run * INPUT_SIZE, pack.run_pairs(run), sink);
+            }
+
+            for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+                run_data_reader_.set_arg(arg_reader_input + p, buffer_reader_[p]);
+            }
+            return scores;
+        }
+
+    private:
+        // Packing runs on the calling thread; keep it next to the card's memory
+        void pin_caller() {
+            if (numa_node_ < 0 || pinned_ == std::this_thread::get_id()) return;
+            pin_thread_to_node(numa_node_);
+            pinned_ = std::this_thread::get_id();
+        }
+
+        static ScoreSink copy_to(Scores& scores) {
+            return [&scores](size_t first, const int32_t* part, size_t count) {
+                std::copy(part, part + count, scores.data() + first);
+            };
+        }
+
+        void pack_chunk(const Batch& batch, size_t first, size_t count) {
+            {
+                trace::Span span("pack");
+                for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+                    if (count < INPUT_SIZE) std::fill(ports_[p], ports_[p] + port_words(INPUT_SIZE), input_t(0));
+                }
+                pack_striped(batch.target, batch.database, first, count, ports_);
+            }
+            {
+                trace::Span span("h2d_sync");
+                for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+                    buffer_reader_[p].sync(XCL_BO_SYNC_BO_TO_DEVICE);
+                }
+            }
+        }
+
+        // Runs one INPUT_SIZE graph iteration on the bound inputs. Scores are
+        // drained from the result ring while the kernels run; the first count
+        // go to sink as pairs first, first + 1, ...
+        void launch(size_t first, size_t count, const ScoreSink& sink) {
+            control_[RING_WRITE_INDEX] = 0;
+            control_[RING_READ_INDEX] = 0;
+            buffer_control_.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+
+            trace::Span span("kernel", count * (uint64_t)SEQ_SIZE * SEQ_SIZE);
+            run_output_sink_.start();
+            run_data_reader_.start();
+
+            drain_ring(first, count, sink);
+
+            run_data_reader_.wait();
+            run_output_sink_.wait();
+        }
+
+        void drain_ring(size_t first, size_t count, const ScoreSink& sink) {
+#ifdef PROFILE_AIE
+            int32_t profile_words[PROFILE_TAIL_WORDS];
+#endif
+            size_t consumed = 0;
+            // When the first results came in, to time the blocks after them
+            std::chrono::steady_clock::time_point first_block;
+            size_t first_words = 0;
+            while (consumed < OUTPUT_WORDS) {
+                size_t written = ring_written();
+                if (written == consumed) {
+                    if (!sink_finished()) {
+                        wait_for_block(consumed);
+                        continue;
+                    }
+                    // The index may have moved just before the kernel finished
+                    written = ring_written();
+                    if (written == consumed) {
+                        throw std::runtime_error("[SWAIE] output_sink on " + name() + " stopped after " +
+                            std::to_string(consumed) + " of " + std::to_string(OUTPUT_WORDS) + " results");
+                    }
+                }
+
+                // One slice per contiguous stretch of the ring
+                while (consumed < written) {
+                    size_t slot = consumed & (RESULT_RING_WORDS - 1);
+                    size_t n = std::min<size_t>(written - consumed, RESULT_RING_WORDS - slot);
+                    {
+                        trace::Span span("d2h_sync");
+                        buffer_output_.sync(XCL_BO_SYNC_BO_FROM_DEVICE, n * sizeof(int32_t), slot * sizeof(int32_t));
+                    }
+                    const int32_t* words = output_ + slot;
+                    if (consumed < count) sink(first + consumed, words, std::min(n, count - consumed));
+#ifdef PROFILE_AIE
+                    for (size_t i = std::max<size_t>(consumed, INPUT_SIZE); i < consumed + n; i++) {
+                        profile_words[i - INPUT_SIZE] = words[i - consumed];
+                    }
+#endif
+                    consumed += n;
+                }
+
+                control_[RING_READ_INDEX] = (int32_t)consumed;
+                buffer_control_.sync(XCL_BO_SYNC_BO_TO_DEVICE, sizeof(int32_t), RING_READ_INDEX * sizeof(int32_t));
+                if (first_words == 0) {
+                    first_block = std::chrono::steady_clock::now();
+                    first_words = consumed;
+                }
+            }
+            if (consumed > first_words) {
+                block_time_ = (std::chrono::steady_clock::now() - first_block) * NUM_TMP_WRITE / (consumed - first_words);
+            }
+
+#ifdef PROFILE_AIE
+            std::vector<TileProfile> run = decode_profile(profile_words, 1);
+            for (int t = 0; t < PARTITION_TILES; t++) profile_[t] += run[t];
+#endif
+        }
+
+        // Every poll of the ring is a sync through XRT, so between blocks it
+        // sleeps half the time output_sink took per NUM_TMP_WRITE block on
+        // the last run. The first run, with no estimate yet, and the last
+        // block of every run poll with a yield so the tail is not delayed.
+        void wait_for_block(size_t consumed) {
+            if (block_time_.count() == 0 || OUTPUT_WORDS - consumed <= NUM_TMP_WRITE) {
+                std::this_thread::yield();
+            } else {
+                std::this_thread::sleep_for(block_time_ / 2);
+            }
+        }
+
+        size_t ring_written() {
+            buffer_control_.sync(XCL_BO_SYNC_BO_FROM_DEVICE, sizeof(int32_t), RING_WRITE_INDEX * sizeof(int32_t));
+            return (uint32_t)control_[RING_WRITE_INDEX];
+        }
+
+        bool sink_finished() {
+            ert_cmd_state state = run_output_sink_.state();
+            return state != ERT_CMD_STATE_NEW && state != ERT_CMD_STATE_QUEUED &&
+                state != ERT_CMD_STATE_SUBMITTED && state != ERT_CMD_STATE_RUNNING;
+        }
+
+        unsigned device_id_;
+        int partition_;
+        xrt::device device_;
+        xrt::uuid uuid_;
+        xrt::kernel data_reader_;
+        xrt::kernel output_sink_;
+        // Declared before the buffers that point into it, so it outlives them
+        std::vector<HostBuffer> host_;
+        std::vector<xrt::bo> buffer_reader_;
+        // Result ring and its write/read indices, see RESULT_RING_WORDS
+        xrt::bo buffer_output_;
+        xrt::bo buffer_control_;
+        xrt::run run_data_reader_;
+        xrt::run run_output_sink_;
+        input_t* ports_[NUM_INPUT_PORTS];
+        const int32_t* output_;
+        int32_t* control_;
+        int numa_node_ = -1;
+        std::thread::id pinned_;
+        // Time output_sink took per NUM_TMP_WRITE results on the last run
+        std::chrono::steady_clock::duration block_time_{0};
+#ifdef PROFILE_AIE
+        std::vector<TileProfile> profile_ = std::vector<TileProfile>(PARTITION_TILES);
+#endif
+    };
+
+    std::vector<std::unique_ptr<Backend>> make_xrt_partition_backends(const std::string& xclbin_file, unsigned device_id, HostMemory memory) {
+        xrt::device device(device_id);
+        xrt::uuid uuid = device.load_xclbin(xclbin_file);
+        std::vector<std::unique_ptr<Backend>> partitions;
+        for (int p = 0; p < NUM_PARTITIONS; p++) {
+            partitions.push_back(std::make_unique<XrtBackend>(device, uuid, device_id, memory, p));
+        }
+        return partitions;
+    }
+
+    std::unique_ptr<Backend> make_xrt_backend(const std::string& xclbin_file, unsigned device_id, HostMemory memory) {
+        std::vector<std::unique_ptr<Backend>> partitions = make_xrt_partition_backends(xclbin_file, device_id, memory);
+        if (partitions.size() == 1) return std::move(partitions[0]);
+        return make_sharded_backend(std::move(partitions));
+    }
+
+    std::unique_ptr<Backend> make_xrt_backend(const std::string& xclbin_file, const std::vector<unsigned>& device_ids, HostMemory memory) {
+        if (device_ids.empty()) throw std::runtime_error("[SWAIE] No accelerator card to run on");
+        if (device_ids.size() == 1) return make_xrt_backend(xclbin_file, device_ids[0], memory);
+
+        std::vector<std::unique_ptr<Backend>> shards;
+        for (unsigned id : device_ids) shards.push_back(make_xrt_backend(xclbin_file, id, memory));
+        return make_sharded_backend(std::move(shards));
+    }
+
+    unsigned xrt_device_count() {
+        return xrt::system::enumerate_devices();
+    }
+
+    std::vector<unsigned> parse_device_list(const std::string& spec) {
+        std::vector<unsigned> ids;
+        if (spec == "all") {
+            unsigned count = xrt_device_count();
+            for (unsigned id = 0; id < count; id++) ids.push_back(id);
+            if (ids.empty()) throw std::runtime_error("[SWAIE] XRT reports no accelerator card");
+            return ids;
+        }
+
+        std::stringstream list(spec);
+        std::string item;
+        while (std::getline(list, item, ',')) {
+            char* end = nullptr;
+            unsigned long id = std::strtoul(item.c_str(), &end, 10);
+            if (item.empty() || *end != '\0') throw std::runtime_error("[SWAIE] Bad device list: " + spec);
+            if (std::find(ids.begin(), ids.end(), (unsigned)id) == ids.end()) ids.push_back((unsigned)id);
+        }
+        if (ids.empty()) throw std::runtime_error("[SWAIE] Bad device list: " + spec);
+        return ids;
+    }
+
+} // namespace swaie
@@ -0,0 +1,494 @@
+/*
+MIT License
+
+Copyright (c) 2025 Carmine Pacilio
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <cmath>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <functional>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+#include "../common/fastareader.h"
+#include "../common/seqreader.h"
+#include "../common/packer.h"
+#include "../common/golden.h"
+#include "../common/score_cache.h"
+#include "../common/cpu_kernels.h"
+
+// CPU-only microbenchmarks for the host path: parsers, packer and alignment
+// engines. No card or XRT runtime is needed, so it runs on CI machines.
+// The engines are compared at SEQ_SIZE; cpu-simd is also swept over read
+// length, through its per-length kernels and the generic one.
+
+struct Result {
+	std::string name;
+	std::map<std::string, std::string> params;
+	std::string unit;
+	std::vector<double> samples;
+
+	double mean() const {
+		double s = 0;
+		for (double x : samples) s += x;
+		return s / samples.size();
+	}
+	double stddev() const {
+		if (samples.size() < 2) return 0;
+		double m = mean(), s = 0;
+		for (double x : samples) s += (x - m) * (x - m);
+		return std::sqrt(s / (samples.size() - 1));
+	}
+};
+
+struct Options {
+	int reps = 5;
+	bool quick = false;
+	std::string json_file;
+	std::string filter;
+};
+
+static Options options;
+static std::vector<Result> results;
+
+// Runs fn once to warm up, then options.reps times. fn returns the work done
+// (bytes, pairs, cells); each sample is work / seconds / scale.
+static void measure(const std::string& name, std::map<std::string, std::string> params,
+	const std::string& unit, double scale, const std::function<double()>& fn) {
+
+	if (!options.filter.empty() && name.find(options.filter) == std::string::npos) return;
+
+	Result r{name, std::move(params), unit, {}};
+	fn();
+	for (int i = 0; i < options.reps; i++) {
+		auto start = std::chrono::steady_clock::now();
+		double work = fn();
+		auto stop = std::chrono::steady_clock::now();
+		double seconds = std::chrono::duration<double>(stop - start).count();
+		r.samples.push_back(work / seconds / scale);
+	}
+
+	std::cout << "[BENCH] " << std::left << std::setw(24) << r.name << std::right;
+	for (const auto& p : r.params) std::cout << " " << p.first << "=" << p.second;
+	std::cout << std::fixed << std::setprecision(3) << "  " << r.mean() << " +- " << r.stddev() << " " << r.unit << std::endl;
+	results.push_back(std::move(r));
+}
+
+/////////////////////////		DATASET GENERATION 		////////////////////////////////////
+
+static std::string random_bases(std::mt19937_64& rng, size_t len) {
+	static const char alphabet[] = "ACGT";
+	std::string s(len, 'A');
+	for (char& c : s) c = alphabet[rng() & 3];
+	return s;
+}
+
+// FASTA with 2 * pairs records of length len, sequence lines wrapped at 80
+static std::string make_fasta(size_t pairs, size_t len, uint64_t seed) {
+	std::mt19937_64 rng(seed);
+	std::string out;
+	for (size_t i = 0; i < 2 * pairs; i++) {
+		out += ">r" + std::to_string(i) + "\n";
+		std::string seq = random_bases(rng, len);
+		for (size_t p = 0; p < len; p += 80) out.append(seq, p, 80).push_back('\n');
+	}
+	return out;
+}
+
+static std::string fasta_to_fastq(const std::string& fasta) {
+	std::stringstream in(fasta);
+	std::string line, out, seq, name;
+	auto flush = [&] {
+		if (name.empty()) return;
+		out += "@" + name + "\n" + seq + "\n+\n" + std::string(seq.size(), 'I') + "\n";
+		seq.clear();
+	};
+	while (std::getline(in, line)) {
+		if (line[0] == '>') { flush(); name = line.substr(1); }
+		else seq += line;
+	}
+	flush();
+	return out;
+}
+
+static std::string gzip_bytes(const std::string& data) {
+	uLongf bound = compressBound(data.size()) + 32;
+	std::string out(bound, '\0');
+	z_stream zs;
+	std::memset(&zs, 0, sizeof(zs));
+	deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY);
+	zs.next_in = (Bytef*)data.data();
+	zs.avail_in = data.size();
+	zs.next_out = (Bytef*)&out[0];
+	zs.avail_out = out.size();
+	deflate(&zs, Z_FINISH);
+	out.resize(zs.total_out);
+	deflateEnd(&zs);
+	return out;
+}
+
+// BGZF: independent gzip members of at most 64 KiB input, each recording its size
+static std::string bgzf_bytes(const std::string& data) {
+	std::string out;
+	const size_t block = 60000;
+	for (size_t off = 0; off <= data.size(); off += block) {
+		size_t n = std::min(block, data.size() - off);
+		std::string deflated(compressBound(n) + 16, '\0');
+		z_stream zs;
+		std::memset(&zs, 0, sizeof(zs));
+		deflateInit2(&zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY);
+		zs.next_in = (Bytef*)data.data() + off;
+		zs.avail_in = n;
+		zs.next_out = (Bytef*)&deflated[0];
+		zs.avail_out = deflated.size();
+		deflate(&zs, Z_FINISH);
+		deflated.resize(zs.total_out);
+		deflateEnd(&zs);
+
+		size_t bsize = deflated.size() + 25;
+		const unsigned char header[18] = {31, 139, 8, 4, 0, 0, 0, 0, 0, 255, 6, 0, 'B', 'C', 2, 0,
+			(unsigned char)(bsize & 0xff), (unsigned char)(bsize >> 8)};
+		uint32_t crc = crc32(0, (const Bytef*)data.data() + off, n), isize = n;
+		out.append((const char*)header, sizeof(header)).append(deflated);
+		for (int b = 0; b < 4; b++) out.push_back((char)(crc >> (8 * b)));
+		for (int b = 0; b < 4; b++) out.push_back((char)(isize >> (8 * b)));
+		if (n == 0) break;
+	}
+	return out;
+}
+
+static std::string write_temp(const std::string& data, const std::string& suffix) {
+	const char* dir = std::getenv("TMPDIR");
+	std::string path = std::string(dir ? dir : "/tmp") + "/swaie_bench_XXXXXX" + suffix;
+	int fd = mkstemps(&path[0], suffix.size());
+	if (fd < 0 || write(fd, data.data(), data.size()) != (ssize_t)data.size()) {
+		std::cerr << "[BENCH] Cannot write temporary file " << path << std::endl;
+		exit(EXIT_FAILURE);
+	}
+	close(fd);
+	return path;
+}
+
+static swaie::Batch make_batch(size_t pairs, uint64_t seed, size_t length = SEQ_SIZE) {
+	std::mt19937_64 rng(seed);
+	swaie::Batch batch;
+	for (size_t i = 0; i < pairs; i++) {
+		uint8_t* t = batch.target.append(length + 2, 2 * i);
+		uint8_t* d = batch.database.append(length + 2, 2 * i + 1);
+		std::fill_n(t, length + 2, 4);
+		std::fill_n(d, length + 2, 4);
+		for (size_t j = 0; j < length; j++) {
+			t[j] = rng() & 3;
+			// ~75% identity so the DP does real work
+			d[j] = (rng() & 3) ? t[j] : (uint8_t)(rng() & 3);
+		}
+	}
+	return batch;
+}
+
+/////////////////////////		BENCHMARKS 		////////////////////////////////////
+
+// Legacy parser: reads exactly INPUT_SIZE pairs, progress bar included
+static void bench_fastareader() {
+	std::string fasta = make_fasta(INPUT_SIZE, SEQ_SIZE, 1);
+	std::string path = write_temp(fasta, ".fasta");
+	std::ofstream devnull("/dev/null");
+	int null_fd = open("/dev/null", O_WRONLY);
+	int saved_fd = dup(STDERR_FILENO);
+
+	// Its progress output (and ioctl complaints off a tty) is part of the cost, not of the report
+	measure("readFastaFile", {{"len", std::to_string(SEQ_SIZE)}}, "MB/s", 1e6, [&] {
+		std::streambuf* saved = std::cout.rdbuf(devnull.rdbuf());
+		dup2(null_fd, STDERR_FILENO);
+		auto data = fastareader::readFastaFile(path);
+		dup2(saved_fd, STDERR_FILENO);
+		std::cout.rdbuf(saved);
+		return (double)fasta.size();
+	});
+	close(saved_fd);
+	close(null_fd);
+	unlink(path.c_str());
+}
+
+static void bench_seqreader(const std::vector<unsigned>& thread_counts) {
+	const size_t total_bases = options.quick ? 4 << 20 : 32 << 20;
+	std::vector<size_t> lengths = options.quick ? std::vector<size_t>{150} : std::vector<size_t>{100, 150, 250, 1000};
+
+	for (size_t len : lengths) {
+		std::string fasta = make_fasta(total_bases / len / 2, len, len);
+		struct Input { std::string format; std::string data; };
+		std::vector<Input> inputs = {
+			{"fasta", fasta},
+			{"fastq", fasta_to_fastq(fasta)},
+			{"fasta.gz", gzip_bytes(fasta)},
+			{"fasta.bgzf", bgzf_bytes(fasta)},
+		};
+
+		for (const Input& in : inputs) {
+			std::string path = write_temp(in.data, "." + in.format);
+			// Only BGZF inflates in parallel
+			std::vector<unsigned> sweep = in.format == "fasta.bgzf" ? thread_counts : std::vector<unsigned>{1};
+			for (unsigned threads : sweep) {
+				swaie::ReaderOptions ro;
+				ro.max_len = 0;
+				ro.fixed_length = false;
+				ro.threads = threads;
+				measure("SequenceReader", {{"format", in.format}, {"len", std::to_string(len)}, {"threads", std::to_string(threads)}},
+					"MB/s", 1e6, [&] {
+					swaie::SequenceReader reader(path, ro);
+					std::vector<swaie::alphabet_datatype> seq;
+					while (reader.next(seq)) {}
+					// Throughput of the decoded FASTA text, whatever the container
+					return (double)fasta.size();
+				});
+			}
+			unlink(path.c_str());
+		}
+	}
+}
+
+static void bench_packer() {
+	std::vector<size_t> sizes = options.quick ? std::vector<size_t>{INPUT_SIZE} : std::vector<size_t>{500, INPUT_SIZE, 4 * INPUT_SIZE};
+	for (size_t pairs : sizes) {
+		swaie::Batch batch = make_batch(pairs, 2);
+		size_t runs = (pairs + INPUT_SIZE - 1) / INPUT_SIZE;
+		std::vector<std::vector<swaie::input_t>> ports(NUM_INPUT_PORTS, std::vector<swaie::input_t>(swaie::port_words(INPUT_SIZE)));
+
+		measure("pack_striped", {{"pairs", std::to_string(pairs)}}, "Mpairs/s", 1e6, [&] {
+			swaie::input_t* dst[NUM_INPUT_PORTS];
+			for (int p = 0; p < NUM_INPUT_PORTS; p++) dst[p] = ports[p].data();
+			for (size_t r = 0; r < runs; r++) {
+				size_t first = r * INPUT_SIZE;
+				swaie::pack_striped(batch.target, batch.database, first, std::min<size_t>(INPUT_SIZE, pairs - first), dst);
+			}
+			return (double)pairs;
+		});
+	}
+
+	swaie::Batch batch = make_batch(1024, 3);
+	measure("pair_key", {{"pairs", "1024"}}, "Mpairs/s", 1e6, [&] {
+		uint64_t sink = 0;
+		for (size_t i = 0; i < batch.size(); i++) sink ^= swaie::pair_key(batch.target[i], batch.database[i]).lo;
+		if (sink == 42) std::cout << "";
+		return (double)batch.size();
+	});
+}
+
+// cpu-striped against compute_golden before it is timed, on reads with N
+// (code 15) and pad codes, which the reference compares like any base.
+// Lengths cross the lane and segment boundaries; half the pairs are
+// related, so scores also go past the 8-bit cells.
+static void check_striped() {
+	std::mt19937_64 rng(9);
+	const uint8_t codes[] = {0, 1, 2, 3, 4, 15, 15, 15};
+	const size_t lengths[] = {0, 1, 3, 31, 32, 33, 63, 64, 65, 150, 300, 700};
+	swaie::Batch batch;
+	for (size_t a : lengths) {
+		for (size_t b : lengths) {
+			size_t n = batch.size();
+			uint8_t* t = batch.target.append(a, 2 * n);
+			uint8_t* d = batch.database.append(b, 2 * n + 1);
+			for (size_t j = 0; j < a; j++) t[j] = codes[rng() & 7];
+			for (size_t j = 0; j < b; j++) d[j] = (n & 1) && j < a && (rng() & 7) ? t[j] : codes[rng() & 7];
+		}
+	}
+
+	for (size_t length : {(size_t)0, (size_t)SEQ_SIZE}) {
+		swaie::Scores scores = swaie::make_cpu_striped_backend(1, length)->align(batch);
+		size_t wrong = 0;
+		for (size_t i = 0; i < batch.size(); i++) {
+			size_t longest = std::max(batch.target[i].size(), batch.database[i].size());
+			if (scores[i] != swaie::compute_golden(batch.target[i], batch.database[i], length ? length : longest)) wrong++;
+		}
+		if (wrong) {
+			std::cerr << "[BENCH] cpu-striped: " << wrong << " of " << batch.size() << " scores differ from compute_golden (len "
+				<< length << ")" << std::endl;
+			exit(EXIT_FAILURE);
+		}
+	}
+}
+
+static void bench_engines(const std::vector<unsigned>& thread_counts) {
+	const double cells_per_pair = (double)SEQ_SIZE * SEQ_SIZE;
+
+	std::vector<size_t> golden_sizes = options.quick ? std::vector<size_t>{64} : std::vector<size_t>{64, 512};
+	for (size_t pairs : golden_sizes) {
+		swaie::Batch batch = make_batch(pairs, 4);
+		measure("compute_golden", {{"pairs", std::to_string(pairs)}}, "GCUPS", 1e9, [&] {
+			int32_t sink = 0;
+			for (size_t i = 0; i < batch.size(); i++) sink += swaie::compute_golden(batch.target[i], batch.database[i]);
+			if (sink == -1) std::cout << "";
+			return pairs * cells_per_pair;
+		});
+	}
+
+	std::vector<size_t> simd_sizes = options.quick ? std::vector<size_t>{1024} : std::vector<size_t>{256, 2048, INPUT_SIZE};
+	for (size_t pairs : simd_sizes) {
+		swaie::Batch batch = make_batch(pairs, 5);
+		for (unsigned threads : thread_counts) {
+			auto backend = swaie::make_cpu_simd_backend(threads);
+			measure("cpu_simd", {{"pairs", std::to_string(pairs)}, {"threads", std::to_string(threads)}}, "GCUPS", 1e9, [&] {
+				backend->align(batch);
+				return pairs * cells_per_pair;
+			});
+			auto simd8 = swaie::make_cpu_simd8_backend(threads);
+			measure("cpu_simd8", {{"pairs", std::to_string(pairs)}, {"threads", std::to_string(threads)}}, "GCUPS", 1e9, [&] {
+				simd8->align(batch);
+				return pairs * cells_per_pair;
+			});
+		}
+	}
+
+	// One thread per read length: the compiled kernels against the generic
+	// one, which 180 always takes
+	std::vector<size_t> lengths(std::begin(swaie::KERNEL_LENGTHS), std::end(swaie::KERNEL_LENGTHS));
+	lengths.push_back(180);
+	for (size_t length : lengths) {
+		size_t pairs = options.quick ? 256 : 2048;
+		swaie::Batch batch = make_batch(pairs, 7, length);
+		auto backend = swaie::make_cpu_simd_backend(1, length);
+		std::string kernel = swaie::lane_kernel(length) ? "fixed" : "generic";
+		measure("cpu_simd_length", {{"len", std::to_string(length)}, {"kernel", kernel}}, "GCUPS", 1e9, [&] {
+			backend->align(batch);
+			return pairs * (double)length * length;
+		});
+	}
+
+	// Long reads, a few pairs of kilobase matrices: striped within the pair
+	// against the reference loop; scores this high run on 16-bit cells
+	check_striped();
+	std::vector<size_t> long_lengths = options.quick ? std::vector<size_t>{1000} : std::vector<size_t>{1000, 5000};
+	for (size_t length : long_lengths) {
+		size_t pairs = 8;
+		swaie::Batch batch = make_batch(pairs, 8, length);
+		double cells = pairs * (double)length * length;
+		measure("compute_golden_long", {{"len", std::to_string(length)}}, "GCUPS", 1e9, [&] {
+			int32_t sink = 0;
+			for (size_t i = 0; i < batch.size(); i++) sink += swaie::compute_golden(batch.target[i], batch.database[i], length);
+			if (sink == -1) std::cout << "";
+			return cells;
+		});
+		auto striped = swaie::make_cpu_striped_backend(1, length);
+		measure("cpu_striped", {{"len", std::to_string(length)}}, "GCUPS", 1e9, [&] {
+			striped->align(batch);
+			return cells;
+		});
+	}
+
+	// Every pair a cache hit after the warm-up run
+	swaie::Batch batch = make_batch(INPUT_SIZE, 6);
+	auto cached = swaie::make_cached_backend(swaie::make_cpu_simd_backend(1), 1 << 16);
+	std::ofstream devnull("/dev/null");
+	measure("cached_hit", {{"pairs", std::to_string(INPUT_SIZE)}}, "Mpairs/s", 1e6, [&] {
+		cached->align(batch);
+		return (double)INPUT_SIZE;
+	});
+	std::streambuf* saved = std::cout.rdbuf(devnull.rdbuf());
+	cached.reset();
+	std::cout.rdbuf(saved);
+}
+
+static std::string json_string(const std::string& s) {
+	std::string out = "\"";
+	for (char c : s) {
+		if (c == '"' || c == '\\') out.push_back('\\');
+		out.push_back(c);
+	}
+	return out + "\"";
+}
+
+static void write_json(const std::string& path) {
+	std::ofstream out(path);
+	char host[256] = "unknown";
+	gethostname(host, sizeof(host) - 1);
+
+	out << std::setprecision(6) << "{\n  \"host\": " << json_string(host) << ",\n  \"hardware_threads\": "
+		<< std::thread::hardware_concurrency() << ",\n  \"seq_size\": " << SEQ_SIZE << ",\n  \"reps\": " << options.reps
+		<< ",\n  \"benchmarks\": [";
+	for (size_t i = 0; i < results.size(); i++) {
+		const Result& r = results[i];
+		out << (i ? "," : "") << "\n    {\"name\": " << json_string(r.name) << ", \"params\": {";
+		bool first = true;
+		for (const auto& p : r.params) {
+			out << (first ? "" : ", ") << json_string(p.first) << ": " << json_string(p.second);
+			first = false;
+		}
+		out << "}, \"unit\": " << json_string(r.unit) << ", \"mean\": " << r.mean() << ", \"stddev\": " << r.stddev()
+			<< ", \"min\": " << *std::min_element(r.samples.begin(), r.samples.end())
+			<< ", \"max\": " << *std::max_element(r.samples.begin(), r.samples.end()) << ", \"samples\": [";
+		for (size_t s = 0; s < r.samples.size(); s++) out << (s ? ", " : "") << r.samples[s];
+		out << "]}";
+	}
+	out << "\n  ]\n}\n";
+	if (!out) std::cerr << "[BENCH] Cannot write " << path << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--quick") options.quick = true;
+		else if (arg == "--reps" && i + 1 < argc) options.reps = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--json" && i + 1 < argc) options.json_file = argv[++i];
+		else if (arg == "--filter" && i + 1 < argc) options.filter = argv[++i];
+		else {
+			std::cerr << "Usage: " << argv[0] << " [--quick] [--reps <n>] [--json <file>] [--filter <name>]" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	// 1, 2, 4, ... up to every hardware thread
+	std::vector<unsigned> thread_counts;
+	unsigned hw = std::max(1u, std::thread::hardware_concurrency());
+	for (unsigned t = 1; t < hw; t *= 2) thread_counts.push_back(t);
+	thread_counts.push_back(hw);
+	if (options.quick) thread_counts = {1, hw};
+	thread_counts.erase(std::unique(thread_counts.begin(), thread_counts.end()), thread_counts.end());
+
+	try {
+		bench_fastareader();
+		bench_seqreader(thread_counts);
+		bench_packer();
+		bench_engines(thread_counts);
+	} catch (const std::exception &e) {
+		std::cerr << "[BENCH] " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	if (!options.json_file.empty()) {
+		write_json(options.json_file);
+		std::cout << "[BENCH] Results written to " << options.json_file << std::endl;
+	}
+	return 0;
+}
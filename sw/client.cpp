@@ -0,0 +1,69 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/client.h"
+#include "../common/protocol.h"
+#include <cstring>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace swaie {
+
+    Client::Client(const std::string& socket_path) {
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+        fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (fd_ < 0 || ::connect(fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0) {
+            std::string reason = std::strerror(errno);
+            if (fd_ >= 0) ::close(fd_);
+            throw std::runtime_error("[SWAIE CLIENT] Cannot connect to " + socket_path + ": " + reason);
+        }
+    }
+
+    Client::~Client() {
+        ::close(fd_);
+    }
+
+    Scores Client::align(const Batch& batch) {
+        std::string invalid = check_request(batch);
+        if (!invalid.empty()) throw std::runtime_error("[SWAIE CLIENT] Cannot send the batch: " + invalid);
+
+        uint64_t id = next_id_++;
+        if (!send_request(fd_, id, batch)) throw std::runtime_error("[SWAIE CLIENT] Connection lost while sending");
+
+        ResponseHeader header;
+        Scores scores;
+        std::string error;
+        if (!recv_response(fd_, header, scores, error)) throw std::runtime_error("[SWAIE CLIENT] Connection lost while receiving");
+        if (header.status != STATUS_OK) throw std::runtime_error("[SWAIE CLIENT] Server error: " + error);
+        if (header.request_id != id) throw std::runtime_error("[SWAIE CLIENT] Out of order response");
+
+        return scores;
+    }
+
+} // namespace swaie
@@ -0,0 +1,413 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+#include "../common/cpu_kernels.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace swaie {
+
+    // Transposes lane l's first length bases to column l of target/database
+    template <typename Cell, int Lanes>
+    static inline __attribute__((always_inline)) void load_lanes(const Batch& batch, size_t first, size_t count,
+        size_t length, Cell* target, Cell* database) {
+
+        for (int l = 0; l < Lanes; l++) {
+            SequenceView t = (size_t)l < count ? batch.target[first + l] : SequenceView();
+            SequenceView d = (size_t)l < count ? batch.database[first + l] : SequenceView();
+            // Raw pointers: the view accessors are calls in the arch= clones
+            const uint8_t* t_bases = t.data();
+            const uint8_t* d_bases = d.data();
+            size_t t_size = t.size(), d_size = d.size();
+            for (size_t i = 0; i < length; i++) {
+                target[i * Lanes + l] = i < t_size ? t_bases[i] : TARGET_PAD;
+                database[i * Lanes + l] = i < d_size ? d_bases[i] : DATABASE_PAD;
+            }
+        }
+    }
+
+    // One DP row in memory, updated in place: the diagonal and left cells
+    // and the running best stay in registers, one vector per lane group.
+    // Inlined into every kernel, so length is a constant in the fixed ones.
+    // No calls in here: GCC will not inline across the arch= clone boundary,
+    // and an out-of-line std::max leaves the skylake-avx512 clone scalar.
+    // Cells are unsigned and every penalty is a saturating subtraction, so
+    // the local-alignment clamp at 0 costs nothing.
+    template <typename Cell, int Lanes, typename Scoring>
+    static inline __attribute__((always_inline)) void lanes_dp(const Cell* __restrict target,
+        const Cell* __restrict database, Cell* __restrict row, size_t length, size_t count, int32_t* scores) {
+
+        static_assert(Scoring::match > 0 && Scoring::mismatch <= 0 && Scoring::gap <= 0, "saturating lanes need positive matches only");
+        const Cell mismatch = -Scoring::mismatch;
+        const Cell gap = -Scoring::gap;
+
+        Cell best[Lanes] = {};
+        for (size_t k = 0; k < (length + 1) * Lanes; k++) row[k] = 0;
+
+        for (size_t i = 0; i < length; i++) {
+            const Cell* t = target + i * Lanes;
+            Cell diag[Lanes] = {};
+            Cell left[Lanes] = {};
+            for (size_t j = 0; j < length; j++) {
+                const Cell* d = database + j * Lanes;
+                Cell* up = row + (j + 1) * Lanes;
+                for (int l = 0; l < Lanes; l++) {
+                    Cell matched = diag[l] + Scoring::match;
+                    Cell mismatched = diag[l] > mismatch ? diag[l] - mismatch : 0;
+                    Cell from_up = up[l] > gap ? up[l] - gap : 0;
+                    Cell from_left = left[l] > gap ? left[l] - gap : 0;
+                    Cell h = t[l] == d[l] ? matched : mismatched;
+                    h = h > from_up ? h : from_up;
+                    h = h > from_left ? h : from_left;
+                    diag[l] = up[l];
+                    left[l] = h;
+                    up[l] = h;
+                    best[l] = best[l] > h ? best[l] : h;
+                }
+            }
+        }
+
+        for (size_t l = 0; l < count; l++) scores[l] = best[l];
+    }
+
+    template <size_t Length, typename Scoring>
+    static inline __attribute__((always_inline)) void align_lanes(const Batch& batch, size_t first, size_t count, int32_t* scores) {
+        static_assert(Length * Scoring::match <= std::numeric_limits<int16_t>::max(), "scores must fit int16 lanes");
+        alignas(64) uint16_t target[Length][SIMD_LANES];
+        alignas(64) uint16_t database[Length][SIMD_LANES];
+        alignas(64) uint16_t row[Length + 1][SIMD_LANES];
+
+        load_lanes<uint16_t, SIMD_LANES>(batch, first, count, Length, target[0], database[0]);
+        lanes_dp<uint16_t, SIMD_LANES, Scoring>(target[0], database[0], row[0], Length, count, scores);
+    }
+
+    // One instance per compiled length; GCC does not multiversion templates
+    // reliably, so the clones are plain functions around them
+    __attribute__((target_clones("arch=skylake-avx512", "avx2", "default")))
+    static void align_lanes_100(const Batch& batch, size_t first, size_t count, int32_t* scores) {
+        align_lanes<100, DeviceScoring>(batch, first, count, scores);
+    }
+
+    __attribute__((target_clones("arch=skylake-avx512", "avx2", "default")))
+    static void align_lanes_150(const Batch& batch, size_t first, size_t count, int32_t* scores) {
+        align_lanes<150, DeviceScoring>(batch, first, count, scores);
+    }
+
+    __attribute__((target_clones("arch=skylake-avx512", "avx2", "default")))
+    static void align_lanes_250(const Batch& batch, size_t first, size_t count, int32_t* scores) {
+        align_lanes<250, DeviceScoring>(batch, first, count, scores);
+    }
+
+    __attribute__((target_clones("arch=skylake-avx512", "avx2", "default")))
+    static void align_lanes_300(const Batch& batch, size_t first, size_t count, int32_t* scores) {
+        align_lanes<300, DeviceScoring>(batch, first, count, scores);
+    }
+
+    __attribute__((target_clones("arch=skylake-avx512", "avx2", "default")))
+    void align_lanes_generic(const Batch& batch, size_t first, size_t count, size_t length, int32_t* scores) {
+        if (length * DeviceScoring::match > (size_t)std::numeric_limits<int16_t>::max()) {
+            throw std::runtime_error("[CPU SIMD] Sequences of " + std::to_string(length) + " bases overflow 16-bit scores");
+        }
+        // Reused across calls; grows to the longest length the thread has seen
+        thread_local std::vector<uint16_t> buffer;
+        buffer.resize((3 * length + 1) * SIMD_LANES);
+        uint16_t* target = buffer.data();
+        uint16_t* database = target + length * SIMD_LANES;
+        uint16_t* row = database + length * SIMD_LANES;
+
+        load_lanes<uint16_t, SIMD_LANES>(batch, first, count, length, target, database);
+        lanes_dp<uint16_t, SIMD_LANES, DeviceScoring>(target, database, row, length, count, scores);
+    }
+
+    __attribute__((target_clones("arch=skylake-avx512", "avx2", "default")))
+    void align_byte_lanes(const Batch& batch, size_t first, size_t count, size_t length, int32_t* scores) {
+        if (length > BYTE_MAX_LENGTH) {
+            throw std::runtime_error("[CPU SIMD8] Sequences of " + std::to_string(length) + " bases overflow 8-bit scores");
+        }
+        thread_local std::vector<uint8_t> buffer;
+        buffer.resize((3 * length + 1) * BYTE_LANES);
+        uint8_t* target = buffer.data();
+        uint8_t* database = target + length * BYTE_LANES;
+        uint8_t* row = database + length * BYTE_LANES;
+
+        load_lanes<uint8_t, BYTE_LANES>(batch, first, count, length, target, database);
+        lanes_dp<uint8_t, BYTE_LANES, DeviceScoring>(target, database, row, length, count, scores);
+    }
+
+    // One DP row of the prefix-sharing walk: database base against every
+    // target base, from the row above. Diagonal and vertical moves have no
+    // dependency along the row and vectorize; the horizontal ones are a
+    // running max, closed in log2(cols) shifted passes through scratch
+    // (after the pass of shift s a cell has seen 2s cells to its left).
+    static inline __attribute__((always_inline)) int16_t trie_row(const uint8_t* __restrict target, uint8_t base,
+        const int16_t* __restrict up, int16_t* __restrict row, int16_t* __restrict scratch, size_t cols) {
+
+        const int16_t gap = DeviceScoring::gap;
+        row[0] = 0;
+        for (size_t j = 1; j <= cols; j++) {
+            int16_t diag = up[j - 1] + (target[j - 1] == base ? DeviceScoring::match : DeviceScoring::mismatch);
+            int16_t vertical = up[j] + gap;
+            int16_t h = diag > vertical ? diag : vertical;
+            row[j] = h > 0 ? h : 0;
+        }
+        int16_t* src = row;
+        int16_t* dst = scratch;
+        for (size_t s = 1; s < cols; s *= 2) {
+            const int16_t step = (int16_t)(gap * (int)s);
+            for (size_t j = 0; j <= s; j++) dst[j] = src[j];
+            for (size_t j = s + 1; j <= cols; j++) {
+                int16_t h = src[j - s] + step;
+                dst[j] = src[j] > h ? src[j] : h;
+            }
+            std::swap(src, dst);
+        }
+        int16_t best = 0;
+        for (size_t j = 1; j <= cols; j++) best = best > src[j] ? best : src[j];
+        if (src != row) std::memcpy(row, src, (cols + 1) * sizeof(int16_t));
+        return best;
+    }
+
+    int compare_prefix(SequenceView a, SequenceView b, size_t length) {
+        size_t na = std::min(length, a.size()), nb = std::min(length, b.size());
+        int c = std::memcmp(a.data(), b.data(), std::min(na, nb));
+        if (c != 0) return c;
+        return na < nb ? -1 : (na > nb ? 1 : 0);
+    }
+
+    __attribute__((target_clones("arch=skylake-avx512", "avx2", "default")))
+    uint64_t align_prefix_sharing(const Batch& batch, const uint32_t* order, size_t count, size_t length, int32_t* scores) {
+        if (length * DeviceScoring::match > (size_t)std::numeric_limits<int16_t>::max()) {
+            throw std::runtime_error("[CPU TRIE] Sequences of " + std::to_string(length) + " bases overflow 16-bit scores");
+        }
+        // Row k aligns the first k database bases; best[k] is the top score
+        // over rows 0..k. Both stay valid for the previous database's rows.
+        const size_t stride = length + 1;
+        thread_local std::vector<int16_t> buffer;
+        buffer.assign(stride * stride + 2 * stride, 0);
+        int16_t* rows = buffer.data();
+        int16_t* best = rows + stride * stride;
+        int16_t* scratch = best + stride;
+
+        uint64_t cells = 0;
+        SequenceView previous_target, previous_database;
+        for (size_t n = 0; n < count; n++) {
+            SequenceView t = batch.target[order[n]];
+            SequenceView d = batch.database[order[n]];
+            const uint8_t* t_bases = t.data();
+            const uint8_t* d_bases = d.data();
+            size_t cols = std::min(length, t.size());
+            size_t depth = std::min(length, d.size());
+
+            // Rows shared with the previous database, when the columns are the same
+            size_t start = 0;
+            if (n > 0 && compare_prefix(t, previous_target, length) == 0) {
+                size_t shared = std::min(depth, std::min(length, previous_database.size()));
+                const uint8_t* p_bases = previous_database.data();
+                while (start < shared && d_bases[start] == p_bases[start]) start++;
+            }
+
+            for (size_t k = start + 1; k <= depth; k++) {
+                int16_t top = trie_row(t_bases, d_bases[k - 1], rows + (k - 1) * stride, rows + k * stride, scratch, cols);
+                best[k] = best[k - 1] > top ? best[k - 1] : top;
+            }
+            cells += (depth - start) * cols;
+            scores[order[n]] = best[depth];
+            previous_target = t;
+            previous_database = d;
+        }
+        return cells;
+    }
+
+    // Profile rows: one per BITS_PER_CHAR code, N and pads included, as
+    // compute_golden compares raw codes; then one that matches nothing, for
+    // bytes wider than a code, which no reader produces
+    const size_t STRIPED_CODES = 1 << BITS_PER_CHAR;
+    const size_t STRIPED_PROFILES = STRIPED_CODES + 1;
+
+    // Shifts a vector one lane up, as the last segment of lane l continues
+    // into the first of lane l + 1
+    template <typename Cell, int Lanes>
+    static inline __attribute__((always_inline)) void lane_shift(const Cell* __restrict v, Cell* __restrict out) {
+        out[0] = 0;
+        for (int l = 1; l < Lanes; l++) out[l] = v[l - 1];
+    }
+
+    // Target position l * segments + j sits in lane l of segment j. Scores
+    // are biased by -mismatch so the profile is unsigned, and the bias is
+    // taken back with a saturating subtraction that also clamps at 0.
+    template <typename Cell, int Lanes, typename Scoring>
+    static inline __attribute__((always_inline)) void striped_profile(const uint8_t* __restrict target, size_t cols,
+        size_t segments, Cell* __restrict profile) {
+
+        for (size_t r = 0; r < STRIPED_PROFILES; r++) {
+            for (size_t j = 0; j < segments; j++) {
+                for (int l = 0; l < Lanes; l++) {
+                    size_t i = l * segments + j;
+                    bool match = r < STRIPED_CODES && i < cols && target[i] == r;
+                    profile[(r * segments + j) * Lanes + l] = match ? Scoring::match - Scoring::mismatch : 0;
+                }
+            }
+        }
+    }
+
+    // Columns are database bases. The first pass takes diagonal, vertical
+    // and in-lane horizontal moves, which vectorize; horizontal moves that
+    // cross into the next lane are then carried until no lane gains. The
+    // result is the top cell, or limit once a cell may have saturated.
+    template <typename Cell, int Lanes, typename Scoring>
+    static inline __attribute__((always_inline)) Cell striped_dp(const Cell* __restrict profile, size_t segments,
+        const uint8_t* __restrict database, size_t depth, Cell* __restrict load, Cell* __restrict store) {
+
+        static_assert(Scoring::match > 0 && Scoring::mismatch <= 0 && Scoring::gap <= 0, "saturating cells need positive matches only");
+        const Cell max_cell = std::numeric_limits<Cell>::max();
+        const Cell bias = -Scoring::mismatch;
+        const Cell gap = -Scoring::gap;
+        const Cell limit = max_cell - (Scoring::match - Scoring::mismatch);
+
+        Cell best[Lanes] = {};
+        for (size_t k = 0; k < segments * Lanes; k++) store[k] = 0;
+
+        for (size_t i = 0; i < depth; i++) {
+            const Cell* p = profile + (database[i] < STRIPED_CODES ? database[i] : STRIPED_CODES) * segments * Lanes;
+            Cell diag[Lanes];
+            Cell f[Lanes] = {};
+            lane_shift<Cell, Lanes>(store + (segments - 1) * Lanes, diag);
+            Cell* previous = store;
+            store = load;
+            load = previous;
+
+            for (size_t j = 0; j < segments; j++) {
+                const Cell* pj = p + j * Lanes;
+                const Cell* up = load + j * Lanes;
+                Cell* h = store + j * Lanes;
+                for (int l = 0; l < Lanes; l++) {
+                    Cell sum = diag[l] + pj[l];
+                    sum = sum < diag[l] ? max_cell : sum;
+                    Cell v = sum > bias ? sum - bias : 0;
+                    Cell from_up = up[l] > gap ? up[l] - gap : 0;
+                    v = v > from_up ? v : from_up;
+                    v = v > f[l] ? v : f[l];
+                    h[l] = v;
+                    best[l] = best[l] > v ? best[l] : v;
+                    f[l] = v > gap ? v - gap : 0;
+                    diag[l] = up[l];
+                }
+            }
+
+            // Lazy F: stops at the first segment where no lane's carried
+            // gap beats the cell, as the cells after it already saw one
+            Cell carry[Lanes];
+            lane_shift<Cell, Lanes>(f, carry);
+            for (size_t j = 0;;) {
+                Cell* h = store + j * Lanes;
+                int gains = 0;
+                for (int l = 0; l < Lanes; l++) gains |= carry[l] > h[l];
+                if (!gains) break;
+                for (int l = 0; l < Lanes; l++) {
+                    Cell v = h[l] > carry[l] ? h[l] : carry[l];
+                    h[l] = v;
+                    best[l] = best[l] > v ? best[l] : v;
+                    carry[l] = v > gap ? v - gap : 0;
+                }
+                if (++j == segments) {
+                    j = 0;
+                    for (int l = 0; l < Lanes; l++) f[l] = carry[l];
+                    lane_shift<Cell, Lanes>(f, carry);
+                }
+            }
+
+            // Saturated cells only grow: no point finishing the matrix
+            int saturated = 0;
+            for (int l = 0; l < Lanes; l++) saturated |= best[l] >= limit;
+            if (saturated) return limit;
+        }
+
+        Cell top = 0;
+        for (int l = 0; l < Lanes; l++) top = top > best[l] ? top : best[l];
+        return top;
+    }
+
+    template <typename Cell, int Lanes>
+    static inline __attribute__((always_inline)) Cell align_striped_cells(SequenceView target, SequenceView database, size_t length) {
+        const uint8_t* t_bases = target.data();
+        const uint8_t* d_bases = database.data();
+        size_t cols = std::min(length, target.size());
+        size_t depth = std::min(length, database.size());
+        size_t segments = (cols + Lanes - 1) / Lanes;
+        if (segments == 0 || depth == 0) return 0;
+
+        thread_local std::vector<Cell> buffer;
+        buffer.resize((STRIPED_PROFILES + 2) * segments * Lanes);
+        Cell* profile = buffer.data();
+        Cell* load = profile + STRIPED_PROFILES * segments * Lanes;
+        Cell* store = load + segments * Lanes;
+
+        striped_profile<Cell, Lanes, DeviceScoring>(t_bases, cols, segments, profile);
+        return striped_dp<Cell, Lanes, DeviceScoring>(profile, segments, d_bases, depth, load, store);
+    }
+
+    __attribute__((target_clones("arch=skylake-avx512", "avx2", "default")))
+    static uint8_t align_striped_bytes(SequenceView target, SequenceView database, size_t length) {
+        return align_striped_cells<uint8_t, BYTE_LANES>(target, database, length);
+    }
+
+    __attribute__((target_clones("arch=skylake-avx512", "avx2", "default")))
+    static uint16_t align_striped_words(SequenceView target, SequenceView database, size_t length) {
+        return align_striped_cells<uint16_t, SIMD_LANES>(target, database, length);
+    }
+
+    int32_t align_striped(SequenceView target, SequenceView database, size_t length) {
+        size_t shorter = std::min({length, target.size(), database.size()});
+        if (shorter > STRIPED_MAX_LENGTH) {
+            throw std::runtime_error("[CPU STRIPED] Sequences of " + std::to_string(shorter) + " bases overflow 16-bit scores");
+        }
+        // Cells this close to the top may have been clipped on their way up
+        const int headroom = DeviceScoring::match - DeviceScoring::mismatch;
+        uint8_t bytes = align_striped_bytes(target, database, length);
+        if (bytes < UINT8_MAX - headroom) return bytes;
+        return align_striped_words(target, database, length);
+    }
+
+    LaneKernel lane_kernel(size_t length) {
+        switch (length) {
+            case 100: return align_lanes_100;
+            case 150: return align_lanes_150;
+            case 250: return align_lanes_250;
+            case 300: return align_lanes_300;
+            default: return nullptr;
+        }
+    }
+
+    size_t longest_sequence(const Batch& batch) {
+        size_t longest = 0;
+        for (size_t i = 0; i < batch.size(); i++) {
+            longest = std::max({longest, batch.target[i].size(), batch.database[i].size()});
+        }
+        return longest;
+    }
+
+} // namespace swaie
@@ -0,0 +1,541 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/dataflow_model.h"
+#include "../common/golden.h"
+#include "../common/packer.h"
+#include <algorithm>
+#include <exception>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
+
+namespace swaie {
+namespace model {
+
+    // Thrown in processes blocked when a deadlock is declared, to unwind them
+    struct Deadlock {};
+
+    static thread_local Process* current = nullptr;
+
+    void advance(double cycles) {
+        current->now += cycles;
+        current->busy += cycles;
+    }
+
+    /////////////////////////		STREAMS 		////////////////////////////////////
+
+    StreamBase::StreamBase(Simulation& sim, std::string name, size_t depth, double latency)
+        : sim_(sim), name_(std::move(name)), depth_(depth ? depth : 1), latency_(latency) {
+        sim_.streams_.push_back(this);
+    }
+
+    std::mutex& StreamBase::mutex() {
+        return sim_.mutex_;
+    }
+
+    size_t StreamBase::size() const {
+        std::lock_guard<std::mutex> lock(sim_.mutex_);
+        return written_.size() - read_.size();
+    }
+
+    bool StreamBase::ready(bool writing) const {
+        size_t queued = written_.size() - read_.size();
+        return writing ? queued < depth_ : queued > 0;
+    }
+
+    void StreamBase::begin_write(std::unique_lock<std::mutex>& lock) {
+        sim_.wait(lock, writable_, *this, true);
+        Process& p = *current;
+        // Word k takes the slot word k - depth left
+        size_t k = written_.size();
+        double t = p.now;
+        if (k >= depth_) t = std::max(t, read_[k - depth_]);
+        p.stall_out += t - p.now;
+        write_stall_ += t - p.now;
+        p.now = t;
+        written_.push_back(t);
+        readable_.notify_one();
+    }
+
+    void StreamBase::begin_read(std::unique_lock<std::mutex>& lock) {
+        sim_.wait(lock, readable_, *this, false);
+        Process& p = *current;
+        size_t k = read_.size();
+        double t = std::max(p.now, written_[k] + latency_);
+        p.stall_in += t - p.now;
+        read_stall_ += t - p.now;
+        p.now = t;
+        read_.push_back(t);
+        writable_.notify_one();
+    }
+
+    StreamStats StreamBase::stats(double end) const {
+        StreamStats s;
+        s.name = name_;
+        s.depth = depth_;
+        s.words = read_.size();
+        s.write_stall = write_stall_;
+        s.read_stall = read_stall_;
+
+        double resident = 0, read_resident = 0;
+        for (size_t k = 0; k < written_.size(); k++) {
+            double leave = k < read_.size() ? read_[k] : end;
+            resident += leave - written_[k];
+            if (k < read_.size()) read_resident += leave - written_[k];
+        }
+        if (end > 0) s.mean_occupancy = resident / end;
+        if (s.words) s.mean_residence = read_resident / s.words;
+
+        // Both timestamp lists are sorted; a read frees its slot before a
+        // write at the same cycle takes it
+        const double never = std::numeric_limits<double>::infinity();
+        size_t w = 0, r = 0, occupancy = 0;
+        double last = 0, full = 0;
+        while (w < written_.size() || r < read_.size()) {
+            double next_write = w < written_.size() ? written_[w] : never;
+            double next_read = r < read_.size() ? read_[r] : never;
+            double t = std::min(next_write, next_read);
+            if (occupancy >= depth_) full += t - last;
+            last = t;
+            if (next_read <= next_write) { occupancy--; r++; }
+            else { occupancy++; w++; }
+            s.max_occupancy = std::max(s.max_occupancy, occupancy);
+        }
+        if (occupancy >= depth_ && end > last) full += end - last;
+        if (end > 0) s.full_fraction = full / end;
+        return s;
+    }
+
+    /////////////////////////		SIMULATION 		////////////////////////////////////
+
+    void Simulation::spawn(std::string name, std::function<void()> body) {
+        processes_.emplace_back();
+        processes_.back().name = std::move(name);
+        bodies_.push_back(std::move(body));
+    }
+
+    void Simulation::wait(std::unique_lock<std::mutex>& lock, std::condition_variable& cv,
+        const StreamBase& stream, bool writing) {
+
+        Process& p = *current;
+        while (!stream.ready(writing)) {
+            if (deadlocked_) throw Deadlock();
+            p.blocked_on = &stream;
+            p.blocked_writing = writing;
+            check_deadlock();
+            if (deadlocked_) {
+                p.blocked_on = nullptr;
+                throw Deadlock();
+            }
+            cv.wait(lock);
+            p.blocked_on = nullptr;
+        }
+    }
+
+    // With the lock held: stuck when every process still running waits on
+    // a stream that cannot move, since only a running process could move it
+    void Simulation::check_deadlock() {
+        std::string stuck;
+        for (const Process& p : processes_) {
+            if (p.done) continue;
+            if (!p.blocked_on || p.blocked_on->ready(p.blocked_writing)) return;
+            if (!stuck.empty()) stuck += ", ";
+            stuck += p.name + (p.blocked_writing ? " writing " : " reading ") + p.blocked_on->name() +
+                (p.blocked_writing ? " (full)" : " (empty)");
+        }
+        if (stuck.empty()) return;
+        deadlocked_ = true;
+        deadlock_ = stuck;
+        notify_all_streams();
+    }
+
+    void Simulation::notify_all_streams() {
+        for (StreamBase* s : streams_) {
+            s->readable_.notify_all();
+            s->writable_.notify_all();
+        }
+    }
+
+    bool Simulation::run() {
+        std::vector<std::thread> threads;
+        std::exception_ptr error;
+        for (size_t i = 0; i < processes_.size(); i++) {
+            threads.emplace_back([this, i, &error] {
+                current = &processes_[i];
+                try {
+                    bodies_[i]();
+                } catch (const Deadlock&) {
+                } catch (...) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    if (!error) error = std::current_exception();
+                    // Unwind the others the same way as on a deadlock
+                    deadlocked_ = true;
+                    notify_all_streams();
+                }
+                std::lock_guard<std::mutex> lock(mutex_);
+                current->done = true;
+                if (!deadlocked_) check_deadlock();
+            });
+        }
+        for (std::thread& t : threads) t.join();
+        if (error) std::rethrow_exception(error);
+        return !deadlocked_;
+    }
+
+    std::vector<StageStats> Simulation::stages() const {
+        std::vector<StageStats> stages;
+        for (const Process& p : processes_) stages.push_back({p.name, p.busy, p.stall_in, p.stall_out, p.now});
+        return stages;
+    }
+
+    std::vector<StreamStats> Simulation::streams(double end) const {
+        std::vector<StreamStats> stats;
+        for (const StreamBase* s : streams_) stats.push_back(s->stats(end));
+        return stats;
+    }
+
+    double Simulation::finish() const {
+        double end = 0;
+        for (const Process& p : processes_) end = std::max(end, p.now);
+        return end;
+    }
+
+    /////////////////////////		DATAFLOW 		////////////////////////////////////
+
+    // The kernels' processes with their hls::stream traffic and a cost per
+    // step; see fpga/data_reader.cpp, aie/src/sw_aie.cpp and fpga/output_sink.cpp
+
+    static void read_input_data(const CostModel& cost, const input_t* input, stream<input_t>& port_stream, size_t port_couples) {
+        advance(cost.axi_read_latency);
+        for (size_t i = 0; i < port_couples * COUPLE_WORDS; i++) {
+            port_stream.write(input[i]);
+            advance(cost.axi_read_ii);
+        }
+    }
+
+    static void dispatcher(const CostModel& cost, stream<input_t>& port_stream,
+        std::vector<stream<input_t>*> reads_stream, size_t port_couples) {
+
+        for (size_t i = 0, idx = 0; i < port_couples; i++, idx = (idx + 1) % reads_stream.size()) {
+            for (size_t j = 0; j < COUPLE_WORDS; j++) {
+                reads_stream[idx]->write(port_stream.read());
+                advance(cost.dispatch_ii);
+            }
+        }
+    }
+
+    // Bases dispatchToAIE sends per sequence, one per PLIO beat
+    const size_t BEAT_BASES = std::max<size_t>(MAX_DIM, UNPACKED_LENGTH);
+
+    static void compute_wrapper(const CostModel& cost, stream<input_t>& reads_stream,
+        stream<int32_t>& target_aie, stream<int32_t>& database_aie, size_t num_iter) {
+
+        input_t input[COUPLE_WORDS];
+        uint8_t target[BEAT_BASES], database[BEAT_BASES];
+        for (size_t n = 0; n < num_iter; n++) {
+            for (size_t i = 0; i < COUPLE_WORDS; i++) {
+                input[i] = reads_stream.read();
+                advance(cost.read_couple_ii);
+            }
+            std::fill_n(target, BEAT_BASES, 4);
+            std::fill_n(database, BEAT_BASES, 4);
+            unpack_couple(input, target, database);
+            advance(cost.unpack_ii * COUPLE_WORDS);
+            for (size_t j = 0; j < MAX_DIM; j++) {
+                target_aie.write(target[j]);
+                database_aie.write(database[j]);
+                advance(cost.plio_ii);
+            }
+        }
+    }
+
+    static void compute_sw(const CostModel& cost, stream<int32_t>& in_target, stream<int32_t>& in_database,
+        stream<int32_t>& output, size_t num_iter) {
+
+        // Ping-pong input: the first pair is read up front, pair n + 1 one
+        // vector per stream on each of the first rows of pair n's DP
+        uint8_t target[2][MAX_DIM], database[2][MAX_DIM];
+        const double row = cost.aie_to_pl((double)SEQ_SIZE * cost.aie_cell + cost.aie_row);
+        auto read_v4 = [&](size_t n, size_t i) {
+            for (size_t k = i; k < i + 4; k++) target[n & 1][k] = (uint8_t)in_target.read();
+            for (size_t k = i; k < i + 4; k++) database[n & 1][k] = (uint8_t)in_database.read();
+            advance(cost.aie_to_pl(2 * cost.aie_read_v4));
+        };
+
+        if (num_iter > 0) {
+            for (size_t i = 0; i < MAX_DIM; i += 4) read_v4(0, i);
+        }
+        for (size_t n = 0; n < num_iter; n++) {
+            for (size_t i = 0; i < SEQ_SIZE; i++) {
+                if (n + 1 < num_iter && 4 * i < MAX_DIM) read_v4(n + 1, 4 * i);
+                advance(row);
+            }
+            int32_t score = compute_golden(SequenceView(target[n & 1], SEQ_SIZE), SequenceView(database[n & 1], SEQ_SIZE));
+            output.write(score);
+            advance(cost.aie_to_pl(cost.aie_write));
+        }
+    }
+
+    static void collector(const CostModel& cost, std::vector<stream<int32_t>*> input_stream,
+        stream<int32_t>& final_score_stream, size_t num_iter) {
+
+        for (size_t i = 0; i < num_iter; i++) {
+            for (stream<int32_t>* s : input_stream) {
+                final_score_stream.write(s->read());
+                advance(cost.collector_ii);
+            }
+        }
+    }
+
+    // The ring's depth is its slots, so a full ring holds write_score back
+    // like the host's read index does
+    static void write_score_wrapper(const CostModel& cost, stream<int32_t>& final_score_stream,
+        stream<int32_t>& ring, size_t num_words) {
+
+        std::vector<int32_t> tmp(NUM_TMP_WRITE);
+        size_t to_send = num_words;
+        for (size_t n = 0; n < num_words; n++) {
+            tmp[n % NUM_TMP_WRITE] = final_score_stream.read();
+            advance(cost.write_score_ii);
+            if ((n + 1) % NUM_TMP_WRITE == 0 || n == num_words - 1) {
+                size_t iter = std::min<size_t>(to_send, NUM_TMP_WRITE);
+                advance(cost.write_burst_latency + iter * cost.write_beat);
+                for (size_t i = 0; i < iter; i++) ring.write(tmp[i]);
+                to_send -= iter;
+            }
+        }
+    }
+
+    static void host_reader(const CostModel& cost, stream<int32_t>& ring, Scores& scores) {
+        for (int32_t& score : scores) {
+            score = ring.read();
+            advance(cost.host_word);
+        }
+    }
+
+    ModelReport run_dataflow_model(const ModelConfig& config, const Batch& batch) {
+        const CostModel& cost = config.cost;
+        const size_t pairs = config.pairs;
+        if (config.tiles <= 0 || config.tiles % NUM_INPUT_PORTS != 0) {
+            throw std::runtime_error("[SWMODEL] Tiles must be a positive multiple of the " + std::to_string(NUM_INPUT_PORTS) + " input ports");
+        }
+        if (pairs == 0 || pairs > batch.size()) {
+            throw std::runtime_error("[SWMODEL] Need 1 to " + std::to_string(batch.size()) + " pairs, got " + std::to_string(pairs));
+        }
+        if (pairs % (size_t)config.tiles != 0) {
+            throw std::runtime_error("[SWMODEL] Pairs must be a multiple of the " + std::to_string(config.tiles) + " tiles, got " + std::to_string(pairs));
+        }
+        if (config.ring_words < NUM_TMP_WRITE) {
+            throw std::runtime_error("[SWMODEL] The result ring needs at least " + std::to_string(NUM_TMP_WRITE) + " words");
+        }
+        const size_t tiles = config.tiles;
+        const size_t tiles_per_port = tiles / NUM_INPUT_PORTS;
+
+        // The host's packing, so the model moves the words the card would
+        std::vector<std::vector<input_t>> images(NUM_INPUT_PORTS, std::vector<input_t>(port_words(pairs)));
+        input_t* ports[NUM_INPUT_PORTS];
+        for (int p = 0; p < NUM_INPUT_PORTS; p++) ports[p] = images[p].data();
+        pack_striped(batch.target, batch.database, 0, pairs, ports);
+
+        Simulation sim;
+        std::deque<stream<input_t>> port_stream, reads_stream;
+        std::deque<stream<int32_t>> target_aie, database_aie, tile_score;
+        for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+            port_stream.emplace_back(sim, "port_stream[" + std::to_string(p) + "]", config.port_stream_depth, cost.fifo_latency);
+        }
+        for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+            for (size_t s = 0; s < tiles_per_port; s++) {
+                reads_stream.emplace_back(sim, "reads_stream[" + std::to_string(p) + "][" + std::to_string(s) + "]",
+                    config.reads_stream_depth, cost.fifo_latency);
+            }
+        }
+        for (size_t t = 0; t < tiles; t++) {
+            target_aie.emplace_back(sim, "target_aie[" + std::to_string(t) + "]", config.plio_depth, cost.plio_latency);
+            database_aie.emplace_back(sim, "database_aie[" + std::to_string(t) + "]", config.plio_depth, cost.plio_latency);
+        }
+        for (size_t t = 0; t < tiles; t++) {
+            tile_score.emplace_back(sim, "tile_score[" + std::to_string(t) + "]", config.plio_depth, cost.plio_latency);
+        }
+        stream<int32_t> final_score_stream(sim, "final_score_stream", config.score_stream_depth, cost.fifo_latency);
+        stream<int32_t> ring(sim, "result_ring", config.ring_words, cost.host_poll_latency);
+
+        ModelReport report;
+        report.scores.resize(pairs);
+        const size_t num_iter = pairs / tiles;
+
+        for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+            size_t couples = (pairs - p + NUM_INPUT_PORTS - 1) / NUM_INPUT_PORTS;
+            sim.spawn("read_input_data[" + std::to_string(p) + "]", [&, p, couples] {
+                read_input_data(cost, ports[p], port_stream[p], couples);
+            });
+            std::vector<stream<input_t>*> slots;
+            for (size_t s = 0; s < tiles_per_port; s++) slots.push_back(&reads_stream[p * tiles_per_port + s]);
+            sim.spawn("dispatcher[" + std::to_string(p) + "]", [&, p, couples, slots] {
+                dispatcher(cost, port_stream[p], slots, couples);
+            });
+        }
+        // Tile t is fed by port (t % NUM_INPUT_PORTS), slot (t / NUM_INPUT_PORTS)
+        for (size_t t = 0; t < tiles; t++) {
+            stream<input_t>& reads = reads_stream[(t % NUM_INPUT_PORTS) * tiles_per_port + t / NUM_INPUT_PORTS];
+            sim.spawn("compute_wrapper[" + std::to_string(t) + "]", [&, t] {
+                compute_wrapper(cost, reads, target_aie[t], database_aie[t], num_iter);
+            });
+            sim.spawn("compute_sw[" + std::to_string(t) + "]", [&, t] {
+                compute_sw(cost, target_aie[t], database_aie[t], tile_score[t], num_iter);
+            });
+        }
+        std::vector<stream<int32_t>*> scores_in;
+        for (stream<int32_t>& s : tile_score) scores_in.push_back(&s);
+        sim.spawn("collector", [&] { collector(cost, scores_in, final_score_stream, num_iter); });
+        sim.spawn("write_score", [&] { write_score_wrapper(cost, final_score_stream, ring, pairs); });
+        sim.spawn("host", [&] { host_reader(cost, ring, report.scores); });
+
+        if (!sim.run()) report.deadlock = sim.deadlock();
+        report.cycles = sim.finish();
+        report.stages = sim.stages();
+        report.streams = sim.streams(report.cycles);
+        return report;
+    }
+
+    /////////////////////////		PARAMETERS AND REPORT 		////////////////////////////////////
+
+    struct Parameter {
+        const char* name;
+        std::function<double(const ModelConfig&)> get;
+        std::function<void(ModelConfig&, double)> set;
+    };
+
+    template <typename Field>
+    static Parameter config_field(const char* name, Field ModelConfig::* field) {
+        return {name, [field](const ModelConfig& c) { return (double)(c.*field); },
+            [field](ModelConfig& c, double v) { c.*field = (Field)v; }};
+    }
+
+    static Parameter cost_field(const char* name, double CostModel::* field) {
+        return {name, [field](const ModelConfig& c) { return c.cost.*field; },
+            [field](ModelConfig& c, double v) { c.cost.*field = v; }};
+    }
+
+    static const std::vector<Parameter>& parameters() {
+        static const std::vector<Parameter> table = {
+            config_field("pairs", &ModelConfig::pairs),
+            config_field("tiles", &ModelConfig::tiles),
+            config_field("port_stream_depth", &ModelConfig::port_stream_depth),
+            config_field("reads_stream_depth", &ModelConfig::reads_stream_depth),
+            config_field("score_stream_depth", &ModelConfig::score_stream_depth),
+            config_field("plio_depth", &ModelConfig::plio_depth),
+            config_field("ring_words", &ModelConfig::ring_words),
+            cost_field("pl_mhz", &CostModel::pl_mhz),
+            cost_field("aie_mhz", &CostModel::aie_mhz),
+            cost_field("axi_read_latency", &CostModel::axi_read_latency),
+            cost_field("axi_read_ii", &CostModel::axi_read_ii),
+            cost_field("fifo_latency", &CostModel::fifo_latency),
+            cost_field("dispatch_ii", &CostModel::dispatch_ii),
+            cost_field("read_couple_ii", &CostModel::read_couple_ii),
+            cost_field("unpack_ii", &CostModel::unpack_ii),
+            cost_field("plio_ii", &CostModel::plio_ii),
+            cost_field("plio_latency", &CostModel::plio_latency),
+            cost_field("aie_read_v4", &CostModel::aie_read_v4),
+            cost_field("aie_cell", &CostModel::aie_cell),
+            cost_field("aie_row", &CostModel::aie_row),
+            cost_field("aie_write", &CostModel::aie_write),
+            cost_field("collector_ii", &CostModel::collector_ii),
+            cost_field("write_score_ii", &CostModel::write_score_ii),
+            cost_field("write_burst_latency", &CostModel::write_burst_latency),
+            cost_field("write_beat", &CostModel::write_beat),
+            cost_field("host_poll_latency", &CostModel::host_poll_latency),
+            cost_field("host_word", &CostModel::host_word),
+        };
+        return table;
+    }
+
+    bool set_parameter(ModelConfig& config, const std::string& key, double value) {
+        for (const Parameter& p : parameters()) {
+            if (key == p.name) {
+                p.set(config, value);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void print_parameters(std::ostream& os, const ModelConfig& config) {
+        for (const Parameter& p : parameters()) {
+            os << "  " << std::left << std::setw(22) << p.name << std::right << p.get(config) << std::endl;
+        }
+    }
+
+    static double percent(double part, double whole) {
+        return whole > 0 ? 100 * part / whole : 0;
+    }
+
+    void print_report(std::ostream& os, const ModelConfig& config, const ModelReport& report) {
+        const double total = report.cycles;
+        std::ios_base::fmtflags flags = os.flags();
+        os << std::fixed;
+
+        os << "[SWMODEL] " << config.pairs << " pairs, " << config.tiles << " tiles, reads_stream depth "
+           << config.reads_stream_depth << ", final_score_stream depth " << config.score_stream_depth
+           << ", PLIO depth " << config.plio_depth << std::endl;
+
+        os << std::endl << std::left << std::setw(22) << "stage" << std::right << std::setw(10) << "busy %"
+           << std::setw(12) << "stall in %" << std::setw(13) << "stall out %" << std::setw(14) << "finish" << std::endl;
+        const StageStats* busiest = nullptr;
+        for (const StageStats& s : report.stages) {
+            os << std::left << std::setw(22) << s.name << std::right << std::setprecision(1)
+               << std::setw(10) << percent(s.busy, total) << std::setw(12) << percent(s.stall_in, total)
+               << std::setw(13) << percent(s.stall_out, total) << std::setprecision(0) << std::setw(14) << s.finish << std::endl;
+            if (!busiest || s.busy > busiest->busy) busiest = &s;
+        }
+
+        os << std::endl << std::left << std::setw(22) << "stream" << std::right << std::setw(7) << "depth"
+           << std::setw(10) << "words" << std::setw(10) << "mean occ" << std::setw(9) << "max occ"
+           << std::setw(8) << "full %" << std::setw(11) << "wait cyc" << std::setw(14) << "writer stall"
+           << std::setw(14) << "reader stall" << std::endl;
+        for (const StreamStats& s : report.streams) {
+            os << std::left << std::setw(22) << s.name << std::right << std::setw(7) << s.depth << std::setw(10) << s.words
+               << std::setprecision(2) << std::setw(10) << s.mean_occupancy << std::setw(9) << s.max_occupancy
+               << std::setprecision(1) << std::setw(8) << percent(s.full_fraction, 1) << std::setw(11) << s.mean_residence
+               << std::setprecision(0) << std::setw(14) << s.write_stall << std::setw(14) << s.read_stall << std::endl;
+        }
+        os << std::endl;
+
+        if (!report.deadlock.empty()) {
+            os << "[SWMODEL] Deadlock at cycle " << std::setprecision(0) << total << ": " << report.deadlock << std::endl;
+        } else {
+            double seconds = report.seconds(config.cost);
+            os << "[SWMODEL] Modeled " << std::setprecision(0) << total << " PL cycles, " << std::setprecision(1)
+               << seconds * 1e6 << " us at " << std::setprecision(0) << config.cost.pl_mhz << " MHz, "
+               << std::setprecision(3) << config.pairs / seconds / 1e6 << " Mpairs/s" << std::endl;
+        }
+        if (busiest) {
+            os << "[SWMODEL] Busiest stage: " << busiest->name << " (" << std::setprecision(1)
+               << percent(busiest->busy, total) << "% busy)" << std::endl;
+        }
+        os.flags(flags);
+    }
+
+} // namespace model
+} // namespace swaie
@@ -40,9 +40,9 @@ namespace fastareader {
 
     std::pair< std::vector<std::vector<alphabet_datatype>>, std::vector<std::vector<alphabet_datatype>> > readFastaFile(const std::string& filename) {
         std::vector<std::vector<alphabet_datatype>> target;
-        target.reserve(INPUT_SIZE * MAX_DIM);
+        target.reserve(INPUT_SIZE);
         std::vector<std::vector<alphabet_datatype>> database;
-        database.reserve(INPUT_SIZE * MAX_DIM);
+        database.reserve(INPUT_SIZE);
 
         std::ifstream file(filename);
         if (!file.is_open()) {
@@ -91,6 +91,48 @@ namespace fastareader {
         return {target, database}; 
     }
 
+    std::pair< std::vector<std::vector<alphabet_datatype>>, std::vector<std::vector<alphabet_datatype>> > readLongFastaFile(const std::string& filename, size_t num_pairs, size_t max_len) {
+        std::vector<std::vector<alphabet_datatype>> target;
+        target.reserve(num_pairs);
+        std::vector<std::vector<alphabet_datatype>> database;
+        database.reserve(num_pairs);
+
+        std::ifstream file(filename);
+        if (!file.is_open()) {
+            std::cerr << "[FASTA READER] Error opening file: " << filename << std::endl;
+            abort();
+        }
+
+        std::cout << "[FASTA READER] Begin to read long FASTA from file: " << filename << std::endl;
+
+        std::string line;
+        std::vector<alphabet_datatype> currSeq;
+        auto flush = [&]() {
+            if (currSeq.empty()) return;
+            if (target.size() == database.size()) target.push_back(currSeq);
+            else database.push_back(currSeq);
+            currSeq.clear();
+        };
+
+        while (database.size() < num_pairs && std::getline(file, line)) {
+            if (line.empty()) continue;
+            if (line[0] == '>') {
+                flush();
+                continue;
+            }
+            for (char c : line) {
+                if (currSeq.size() < max_len) currSeq.push_back(compression(c));
+            }
+        }
+        if (database.size() < num_pairs) flush();
+        if (target.size() > database.size()) target.pop_back();
+
+        std::cout << "[FASTA READER] Succesfully read " << database.size() << " sequences pairs." << std::endl;
+        file.close();
+
+        return {target, database};
+    }
+
     alphabet_datatype compression(char letter) {
         switch (letter) {
             case 'A':
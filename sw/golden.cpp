@@ -0,0 +1,56 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/golden.h"
+#include <algorithm>
+
+namespace swaie {
+
+    int compute_golden(SequenceView target, SequenceView database, size_t length){
+        // Cells against missing bases can only lose score, so they are skipped
+        size_t rows = std::min(length, target.size());
+        size_t cols = std::min(length, database.size());
+        std::vector<int> prev_row(cols+1, 0);
+        std::vector<int> curr_row(cols+1, 0);
+        int32_t score = 0;
+
+        for (size_t i = 1; i <= rows; ++i) {
+            for (size_t j = 1; j <= cols; ++j) {
+                int m = (target[i - 1] == database[j - 1]) ? MATCH : MISMATCH;
+
+                int score_diag = prev_row[j - 1] + m;       // match/mismatch
+                int score_up   = prev_row[j] + GAP_OPENING;         // deletion
+                int score_left = curr_row[j - 1] + GAP_OPENING;     // insertion
+
+                curr_row[j] = std::max({0, score_diag, score_up, score_left});
+                score = std::max(score, curr_row[j]);
+            }
+
+            prev_row = curr_row;
+        }
+
+        return score;
+    }
+
+} // namespace swaie
@@ -27,25 +27,22 @@ SOFTWARE.
 #include <sys/ioctl.h>
 #include <string>
 #include <vector>
-#include <limits>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <ap_int.h>
-#include <random>
-#include <time.h>
 
-#include "experimental/xrt_kernel.h"
 #include "../common/common.h"
-#include "../common/fastareader.h"
+#include "../common/backend.h"
+#include "../common/packfile.h"
+#include "../common/trace.h"
+#include "../common/seqreader.h"
+#include "../common/result_writer.h"
 
-#define DEVICE_ID 2
-
-#define arg_reader_input 0
-#define arg_reader_size 1
-
-#define arg_sink_output 1
-#define arg_sink_size 2
+// Every card XRT reports; a list such as "0,2" picks some
+#define DEFAULT_DEVICES "all"
 
 typedef ap_uint<BITS_PER_CHAR> alphabet_datatype;
-typedef ap_uint<PORT_WIDTH> input_t;
 
 std::ostream& bold_on(std::ostream& os);
 std::ostream& bold_off(std::ostream& os);
@@ -53,40 +50,42 @@ std::ostream& red(std::ostream& os);
 std::ostream& green(std::ostream& os);  
 std::ostream& reset(std::ostream& os);
 
-void printConf(const std::vector<alphabet_datatype>& target, const std::vector<alphabet_datatype>& database);
-int compute_golden(std::vector<alphabet_datatype>& target, std::vector<alphabet_datatype>& database);
-std::string toString(const std::vector<alphabet_datatype>& seq);
+void printConf(swaie::SequenceView target, swaie::SequenceView database);
+std::string toString(swaie::SequenceView seq);
 void showProgressBar(int progress, int total);
 
 int main(int argc, char *argv[]) {
 
-	std::string filename;
-	if(argc < 3) filename = "SRR33920980.fasta";
-	else filename = argv[2];
-    
-	std::vector<input_t> input(N_PACK, 0);
-	std::vector<int32_t> hw_score(INPUT_SIZE, 0);
-	std::vector<int32_t> golden_score(INPUT_SIZE, 0);
-
-	int cell_number;
-
-///////////////////////////     LOADING XCLBIN      /////////////////////////// 
-
     if(argc < 2) {
 		std::cerr << bold_on << red << "[SWAIE] Error: No xclbin file provided." << reset << std::endl;
-		std::cerr << "Usage: " << argv[0] << " <xclbin_file>" << std::endl;
+		std::cerr << "Usage: " << argv[0] << " <xclbin_file> [fasta_file|pack_file] [device_id[,device_id...]|all]" << std::endl;
 
 		return EXIT_FAILURE;
 	}
 
     std::string xclbin_file = argv[1];
+	std::string filename = (argc < 3) ? "SRR33920980.fasta" : argv[2];
+	std::string devices = (argc < 4) ? DEFAULT_DEVICES : argv[3];
+
+	// SWAIE_OUTPUT=<file.swres|file.tsv> keeps the accelerator scores;
+	// SWAIE_OUTPUT_DIRECT=1 writes them past the page cache (O_DIRECT)
+	const char* output_file = std::getenv("SWAIE_OUTPUT");
+	const char* output_direct = std::getenv("SWAIE_OUTPUT_DIRECT");
+
+	// SWAIE_TRACE=<file.json> records a host timeline of every phase
+	const char* trace_file = std::getenv("SWAIE_TRACE");
+	if (trace_file) {
+		swaie::trace::enable();
+		swaie::trace::set_thread_name("host");
+	}
+
+///////////////////////////     LOADING XCLBIN      /////////////////////////// 
 
-    // Load xclbin
-    std::cout << bold_on << "[SWAIE] Loading xclbin file: " << xclbin_file << bold_off << std::endl;
-    xrt::device device = xrt::device(DEVICE_ID);
-    xrt::uuid xclbin_uuid;
+    std::cout << bold_on << "[SWAIE] Loading xclbin file: " << xclbin_file << " on devices " << devices << bold_off << std::endl;
+    std::unique_ptr<swaie::Backend> device;
     try {
-        xclbin_uuid = xrt::uuid(device.load_xclbin(xclbin_file));
+        // Several cards share each run through a sharded backend
+        device = swaie::make_xrt_backend(xclbin_file, swaie::parse_device_list(devices));
     } catch (const std::exception &e) {
         std::cerr << bold_on << red << "[SWAIE] Error loading xclbin: " << e.what() << reset << std::endl;
         return EXIT_FAILURE;
@@ -95,90 +94,64 @@ int main(int argc, char *argv[]) {
 
 /////////////////////////		DATASET GENERATION 		////////////////////////////////////
 
-	std::cout << "[SWAIE] Reading "<< INPUT_SIZE << " sequence from fasta file: " << filename << std::endl;
-	auto [target, database] = fastareader::readFastaFile(filename);
-
-	std::vector<alphabet_datatype> tmp(INPUT_SIZE * MAX_DIM * 2, 0);
-	for (int i = 0; i < INPUT_SIZE; i++) {
-		for (int j = 0; j < MAX_DIM; j++) {
-			tmp[j+((SEQ_SIZE + PADDING_SIZE)*2)*i] = target[i][j];
-		}
-		for (int j = MAX_DIM; j < MAX_DIM*2; j++) {
-			tmp[j+((SEQ_SIZE + PADDING_SIZE)*2)*i] = database[i][j-MAX_DIM];
+	// Pack files (see swpack) are run whole and zero copy; anything else is
+	// read and packed, INPUT_SIZE pairs of it
+	swaie::Batch batch;
+	std::unique_ptr<swaie::PackFile> pack;
+	try {
+		swaie::trace::Span span("read");
+		if (swaie::is_packfile(filename)) {
+			pack = std::make_unique<swaie::PackFile>(filename);
+			batch = pack->batch(0, pack->size());
+			std::cout << "[SWAIE] Mapped " << pack->size() << " packed pairs from: " << filename << std::endl;
+		} else {
+			std::cout << "[SWAIE] Reading "<< INPUT_SIZE << " sequence pairs from: " << filename << std::endl;
+			swaie::SequenceReader reader(filename);
+			reader.read_pairs(batch, INPUT_SIZE);
+			std::cout << "[SWAIE] Read " << batch.size() << " pairs, " << reader.format() << std::endl;
 		}
-
-        std::cout << "\r[SWAIE] Packing sequences:";
-		showProgressBar(i + 1, INPUT_SIZE*2);
-	}
-
-	for (int n = 0; n < INPUT_SIZE; n++) {
-		int k = 0;
-		for(int i = 0; i < PACK_SEQ*2 ; i++){
-			for(int j = 0; j < 128; j++){
-				input[n*(PACK_SEQ*2) + i].range(
-					(j+1)*BITS_PER_CHAR-1, j*BITS_PER_CHAR
-				) = tmp[k+((SEQ_SIZE + PADDING_SIZE)*2)*n];
-				k++;
-			}
-		}
-        std::cout << "\r[SWAIE] Packing sequences:";
-		showProgressBar(INPUT_SIZE + n + 1, INPUT_SIZE*2);
+	} catch (const std::exception &e) {
+		std::cerr << bold_on << red << "[SWAIE] Error reading input: " << e.what() << reset << std::endl;
+		return EXIT_FAILURE;
 	}
-    std::cout << std::endl;
-    std::cout << "\033[1;32m[SWAIE] ✔ Packing succesful! \033[0m" << std::endl;
-
-///////////////////////////     INITIAL2IZING THE BOARD     ///////////////////////////  
-	std::cout << "[SWAIE] Programming device: " << std::endl;
-    xrt::kernel data_reader = xrt::kernel(device, xclbin_uuid, "data_reader");
-    xrt::kernel output_sink = xrt::kernel(device, xclbin_uuid, "output_sink");
-
-    xrtMemoryGroup bank_input  = data_reader.group_id(arg_reader_input);
-    xrtMemoryGroup bank_mask = output_sink.group_id(arg_sink_output);
-    int32_t bank_output = ffs(bank_mask)-1;
-
-    std::cout << "- Memory banks initialized succesfully." << std::endl;
-
-    xrt::bo buffer_reader = xrt::bo(device, N_PACK * sizeof(input_t), xrt::bo::flags::normal, bank_input); 
-    xrt::bo buffer_output = xrt::bo(device, 1, xrt::bo::flags::normal, static_cast<xrtMemoryGroup>(bank_output));
-    
-    std::cout << "- Device buffers created succesfully." << std::endl;
-
-    xrt::run run_data_reader = xrt::run(data_reader);
-    xrt::run run_output_sink = xrt::run(output_sink);
-
-    run_data_reader.set_arg(arg_reader_input, buffer_reader);
-    std::cout << "[DEBUG] setted args for data reader input." << std::endl;
-    run_data_reader.set_arg(arg_reader_size, INPUT_SIZE);
-    std::cout << "[DEBUG] setted args for data reader size." << std::endl;
 
-    run_output_sink.set_arg(arg_sink_output, buffer_output);
-    std::cout << "[DEBUG] setted args for output sink output." << std::endl;
-    run_output_sink.set_arg(arg_sink_size, INPUT_SIZE);
-    std::cout << "[DEBUG] setted args for output sink size." << std::endl;
-
-    std::cout << bold_on << green << "[SWAIE] ✔ Device programmed succesfully: " << reset << std::endl;
+///////////////////////////     RUNNING THE BOARD     ///////////////////////////  
 
     std::cout << bold_on << "[SWAIE] Running FPGA accelerator. \n" << bold_off;
 
-    std::cout << "[SWAIE] Writing " << INPUT_SIZE << " sequences to accelarator. \n" << bold_off;
-    // write data into the input buffer
-    buffer_reader.write(input.data());
-    buffer_reader.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+	// Scores reach the writer, from the writer's own thread, while the kernels still run
+	std::unique_ptr<swaie::ResultWriter> results;
+	if (output_file) {
+		try {
+			swaie::WriterOptions options;
+			options.direct = output_direct && std::string(output_direct) == "1";
+			results = std::make_unique<swaie::ResultWriter>(output_file, swaie::result_format_for(output_file), options);
+		} catch (const std::exception &e) {
+			std::cerr << bold_on << red << "[SWAIE] Error writing results: " << e.what() << reset << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
 
     auto start = std::chrono::high_resolution_clock::now();
-    // run the kernel
-    run_output_sink.start();
-    run_data_reader.start();
-
-    // wait for the kernel to finish
-    run_data_reader.wait();
-    run_output_sink.wait();
+    swaie::Scores hw_score;
+    try {
+        if (pack) {
+            hw_score = device->align_packed(*pack);
+            if (results) results->write(0, hw_score);
+        } else {
+            hw_score.resize(batch.size());
+            device->align_streaming(batch, [&](size_t first, const int32_t* scores, size_t count) {
+                std::copy(scores, scores + count, hw_score.begin() + first);
+                if (results) results->write(first, scores, count);
+            });
+        }
+    } catch (const std::exception &e) {
+        std::cerr << bold_on << red << "[SWAIE] Error running the accelerator: " << e.what() << reset << std::endl;
+        return EXIT_FAILURE;
+    }
     auto stop = std::chrono::high_resolution_clock::now();
-    std::cout << "[SWAIE] Reading results." << bold_off;
-    // read the output buffer
-    buffer_output.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
-    buffer_output.read(hw_score.data()); 
 
+    double cell_number = (double)batch.size() * SEQ_SIZE * SEQ_SIZE;
     auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
     float gcup = (double) (cell_number / (float)duration.count());
     
@@ -191,9 +164,7 @@ int main(int argc, char *argv[]) {
 	std::cout << bold_on << "[SWAIE] Running Software version." << bold_off << std::endl;;
 	start = std::chrono::high_resolution_clock::now();
 
-	for (int golden_rep = 0; golden_rep < INPUT_SIZE; golden_rep++) {
-		golden_score[golden_rep] = compute_golden(target[golden_rep], database[golden_rep]);
-	}
+	swaie::Scores golden_score = swaie::make_cpu_reference_backend()->align(batch);
 
 	stop = std::chrono::high_resolution_clock::now();
 	duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
@@ -204,20 +175,38 @@ int main(int argc, char *argv[]) {
 
 	////////test bench results
 	bool test_score=true;
-	for (int i=0; i < INPUT_SIZE; i++){
+	uint64_t verify_start = swaie::trace::enabled() ? swaie::trace::now_ns() : 0;
+	for (size_t i=0; i < batch.size(); i++){
 		if (hw_score[i]!=golden_score[i]){
             std::cout << bold_on << red << "[SWAIE] Test [" << i << "] FAILED: Output does not match reference." << reset << std::endl;
-			printConf(target[i], database[i]);
+			printConf(batch.target[i], batch.database[i]);
             std::cout << "HW: "<< hw_score[i] << ", SW: " << golden_score[i] << std::endl;
             test_score=false;
         }
         std::cout << "\r[SWAIE] Comparing results: ";
-        showProgressBar(i + 1, INPUT_SIZE);
+        showProgressBar(i + 1, batch.size());
 	}
     std::cout << std::endl;
+	if (verify_start) swaie::trace::record("verify", verify_start, swaie::trace::now_ns());
 
 	if (test_score) std::cout << bold_on << green << "[SWAIE] ✔ Test PASSED: All outputs match are correct." << reset << std::endl;
 	else std::cout << bold_on << red << "[SWAIE] ✖ Test FAILED: Some outputs do not match reference." << reset << std::endl;
+
+	if (results) {
+		try {
+			results->close();
+			std::cout << "[SWAIE] Scores written to " << output_file << std::endl;
+		} catch (const std::exception &e) {
+			std::cerr << bold_on << red << "[SWAIE] Error writing results: " << e.what() << reset << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	if (trace_file) {
+		swaie::trace::print_summary(std::cout);
+		if (swaie::trace::write_chrome_json(trace_file)) std::cout << "[SWAIE] Trace written to " << trace_file << std::endl;
+		else std::cerr << "[SWAIE] Cannot write trace " << trace_file << std::endl;
+	}
 	
 	return 0;
 }
@@ -225,7 +214,7 @@ int main(int argc, char *argv[]) {
 ///////////// UTILITY FUNCTIONS //////////////
 
 //	Prints the current configuration
-void printConf(const std::vector<alphabet_datatype>& target, const std::vector<alphabet_datatype>& database) {
+void printConf(swaie::SequenceView target, swaie::SequenceView database) {
 	std::cout << "+++ Sequence Target: [" << target.size() << "]: " << toString(target) << std::endl;
 	std::cout << "+++ Sequence Database: [" << database.size() << "]: " << toString(database) << std::endl;
 	std::cout << "+++ Match Score: " << MATCH << std::endl;
@@ -233,29 +222,6 @@ void printConf(const std::vector<alphabet_datatype>& target, const std::vector<a
 	std::cout << "+++ Gap Opening: " << GAP_OPENING << std::endl;
 }
 
-int compute_golden(std::vector<alphabet_datatype>& target, std::vector<alphabet_datatype>& database){
-	std::vector<int> prev_row(SEQ_SIZE+1, 0);
-	std::vector<int> curr_row(SEQ_SIZE+1, 0);
-	int32_t score = 0;
-
-	for (int i = 1; i <= SEQ_SIZE; ++i) {
-		for (int j = 1; j <= SEQ_SIZE; ++j) {
-			int m = (target[i - 1] == database[j - 1]) ? MATCH : MISMATCH;
-
-			int score_diag = prev_row[j - 1] + m;       // match/mismatch
-			int score_up   = prev_row[j] + GAP_OPENING;         // deletion
-			int score_left = curr_row[j - 1] + GAP_OPENING;     // insertion
-
-			curr_row[j] = std::max({0, score_diag, score_up, score_left});
-			score = std::max(score, curr_row[j]);
-		}
-
-		prev_row = curr_row;
-	}
-
-	return score;
-}
-
 
 ///////////// PRINTING FUNCTIONS //////////////
 
@@ -286,12 +252,12 @@ std::ostream& reset(std::ostream& os) {
     return os << "\033[0m";
 }
 
-std::string toString(const std::vector<alphabet_datatype>& seq) {
+std::string toString(swaie::SequenceView seq) {
     const std::string alphabet = "ACGT";
     std::string result;
     result.reserve(seq.size());
 
-    for (alphabet_datatype base : seq) {
+    for (uint8_t base : seq) {
         result.push_back(alphabet[base]);
     }
 
@@ -0,0 +1,192 @@
+/*
+MIT License
+
+Copyright (c) 2025 Carmine Pacilio
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <ap_int.h>
+
+#include "experimental/xrt_kernel.h"
+#include "../common/common.h"
+#include "../common/seqreader.h"
+
+#define DEVICE_ID 2
+
+#define arg_long_reader_input 0
+#define arg_long_reader_size 1
+
+#define arg_long_sink_output 1
+#define arg_long_sink_size 2
+
+typedef ap_uint<BITS_PER_CHAR> alphabet_datatype;
+typedef ap_uint<PORT_WIDTH> input_t;
+
+int compute_golden_long(swaie::SequenceView target, swaie::SequenceView database);
+void pack_long(swaie::SequenceView seq, alphabet_datatype pad, input_t* dst);
+
+int main(int argc, char *argv[]) {
+
+	if(argc < 2) {
+		std::cerr << "\033[1;31m[SWAIE LONG] Error: No xclbin file provided.\033[0m" << std::endl;
+		std::cerr << "Usage: " << argv[0] << " <xclbin_file> [fasta_file]" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::string xclbin_file = argv[1];
+	std::string filename = (argc < 3) ? "SRR33920980.fasta" : argv[2];
+
+	std::vector<input_t> input(LONG_N_PACK, 0);
+	std::vector<int32_t> hw_score(LONG_INPUT_SIZE, 0);
+	std::vector<int32_t> golden_score(LONG_INPUT_SIZE, 0);
+
+///////////////////////////     LOADING XCLBIN      /////////////////////////// 
+
+	std::cout << "[SWAIE LONG] Loading xclbin file: " << xclbin_file << std::endl;
+	xrt::device device = xrt::device(DEVICE_ID);
+	xrt::uuid xclbin_uuid;
+	try {
+		xclbin_uuid = xrt::uuid(device.load_xclbin(xclbin_file));
+	} catch (const std::exception &e) {
+		std::cerr << "\033[1;31m[SWAIE LONG] Error loading xclbin: " << e.what() << "\033[0m" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+/////////////////////////		DATASET GENERATION 		////////////////////////////////////
+
+	swaie::Batch pairs;
+	try {
+		swaie::ReaderOptions options;
+		options.max_len = LONG_SEQ_SIZE;
+		options.fixed_length = false;
+		swaie::SequenceReader reader(filename, options);
+		reader.read_pairs(pairs, LONG_INPUT_SIZE);
+	} catch (const std::exception &e) {
+		std::cerr << "\033[1;31m[SWAIE LONG] Error reading input: " << e.what() << "\033[0m" << std::endl;
+		return EXIT_FAILURE;
+	}
+	const auto& target = pairs.target;
+	const auto& database = pairs.database;
+	if (target.size() < LONG_INPUT_SIZE) {
+		std::cerr << "\033[1;31m[SWAIE LONG] Error: " << filename << " holds only " << target.size()
+			<< " pairs, " << LONG_INPUT_SIZE << " needed.\033[0m" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	// Per pair: database words first, then target words (see long_reader)
+	for (int n = 0; n < LONG_INPUT_SIZE; n++) {
+		pack_long(database[n], LONG_DATABASE_PAD, &input[n*(LONG_PACK_SEQ*2)]);
+		pack_long(target[n], LONG_TARGET_PAD, &input[n*(LONG_PACK_SEQ*2) + LONG_PACK_SEQ]);
+	}
+	std::cout << "\033[1;32m[SWAIE LONG] ✔ Packing succesful! \033[0m" << std::endl;
+
+///////////////////////////     INITIALIZING THE BOARD     ///////////////////////////  
+
+	xrt::kernel long_reader = xrt::kernel(device, xclbin_uuid, "long_reader");
+	xrt::kernel long_sink = xrt::kernel(device, xclbin_uuid, "long_sink");
+
+	xrt::bo buffer_reader = xrt::bo(device, LONG_N_PACK * sizeof(input_t), xrt::bo::flags::normal, long_reader.group_id(arg_long_reader_input));
+	xrt::bo buffer_output = xrt::bo(device, LONG_INPUT_SIZE * sizeof(int32_t), xrt::bo::flags::normal, long_sink.group_id(arg_long_sink_output));
+
+	xrt::run run_long_reader = xrt::run(long_reader);
+	xrt::run run_long_sink = xrt::run(long_sink);
+
+	run_long_reader.set_arg(arg_long_reader_input, buffer_reader);
+	run_long_reader.set_arg(arg_long_reader_size, LONG_INPUT_SIZE);
+	run_long_sink.set_arg(arg_long_sink_output, buffer_output);
+	run_long_sink.set_arg(arg_long_sink_size, LONG_INPUT_SIZE);
+
+	buffer_reader.write(input.data());
+	buffer_reader.sync(XCL_BO_SYNC_BO_TO_DEVICE);
+
+	auto start = std::chrono::high_resolution_clock::now();
+	run_long_sink.start();
+	run_long_reader.start();
+
+	run_long_reader.wait();
+	run_long_sink.wait();
+	auto stop = std::chrono::high_resolution_clock::now();
+
+	buffer_output.sync(XCL_BO_SYNC_BO_FROM_DEVICE);
+	buffer_output.read(hw_score.data());
+
+	double cell_number = (double)LONG_INPUT_SIZE * LONG_SEQ_SIZE * LONG_SEQ_SIZE;
+	auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
+	std::cout << "\t -- FPGA Kernel executed in " << (float)duration.count() * 1e-6 << "ms" << std::endl;
+	std::cout << "\t -- GCUPS: " << cell_number / (double)duration.count() << std::endl;
+
+/////////////////////////			TESTBENCH			////////////////////////////////////
+
+	bool test_score = true;
+	for (int i = 0; i < LONG_INPUT_SIZE; i++) {
+		golden_score[i] = compute_golden_long(target[i], database[i]);
+		if (hw_score[i] != golden_score[i]) {
+			std::cout << "\033[1;31m[SWAIE LONG] Test [" << i << "] FAILED: HW: " << hw_score[i]
+				<< ", SW: " << golden_score[i] << "\033[0m" << std::endl;
+			test_score = false;
+		}
+	}
+
+	if (test_score) std::cout << "\033[1;32m[SWAIE LONG] ✔ Test PASSED: All outputs match are correct.\033[0m" << std::endl;
+	else std::cout << "\033[1;31m[SWAIE LONG] ✖ Test FAILED: Some outputs do not match reference.\033[0m" << std::endl;
+
+	return 0;
+}
+
+///////////// UTILITY FUNCTIONS //////////////
+
+// Packs one sequence in LONG_PACK_SEQ words, padding the tail up to LONG_SEQ_SIZE.
+// Target and database use different pad values so padding never matches.
+void pack_long(swaie::SequenceView seq, alphabet_datatype pad, input_t* dst) {
+	for (int i = 0; i < LONG_PACK_SEQ; i++) {
+		for (int j = 0; j < N_ELEM_BLOCK; j++) {
+			size_t k = (size_t)i * N_ELEM_BLOCK + j;
+			dst[i].range((j+1)*BITS_PER_CHAR-1, j*BITS_PER_CHAR) = (k < seq.size()) ? alphabet_datatype(seq[k]) : pad;
+		}
+	}
+}
+
+int compute_golden_long(swaie::SequenceView target, swaie::SequenceView database){
+	std::vector<int> prev_row(database.size()+1, 0);
+	std::vector<int> curr_row(database.size()+1, 0);
+	int32_t score = 0;
+
+	for (size_t i = 1; i <= target.size(); ++i) {
+		for (size_t j = 1; j <= database.size(); ++j) {
+			int m = (target[i - 1] == database[j - 1]) ? MATCH : MISMATCH;
+
+			int score_diag = prev_row[j - 1] + m;
+			int score_up   = prev_row[j] + GAP_OPENING;
+			int score_left = curr_row[j - 1] + GAP_OPENING;
+
+			curr_row[j] = std::max({0, score_diag, score_up, score_left});
+			score = std::max(score, curr_row[j]);
+		}
+
+		std::swap(prev_row, curr_row);
+	}
+
+	return score;
+}
@@ -0,0 +1,118 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/hostmem.h"
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+namespace swaie {
+
+    const size_t HUGE_PAGE = 2 << 20;
+    const int MPOL_PREFERRED_NODE = 1; // MPOL_PREFERRED, without pulling in libnuma
+
+    int device_numa_node(const std::string& bdf) {
+        std::ifstream file("/sys/bus/pci/devices/" + bdf + "/numa_node");
+        int node = -1;
+        if (!(file >> node)) return -1;
+        return node;
+    }
+
+    bool pin_thread_to_node(int node) {
+        if (node < 0) return false;
+        std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+        std::string list;
+        if (!std::getline(file, list)) return false;
+
+        // cpulist looks like "0-15,32-47"
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        std::stringstream ranges(list);
+        std::string range;
+        while (std::getline(ranges, range, ',')) {
+            int first = 0, last = 0;
+            char dash = 0;
+            std::stringstream r(range);
+            if (!(r >> first)) continue;
+            last = (r >> dash >> last) ? last : first;
+            for (int cpu = first; cpu <= last && cpu < CPU_SETSIZE; cpu++) CPU_SET(cpu, &set);
+        }
+        if (CPU_COUNT(&set) == 0) return false;
+        return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+    }
+
+    HostBuffer::HostBuffer(size_t bytes, int numa_node, bool hugepages) : size_(bytes) {
+        if (hugepages) {
+            mapped_ = (bytes + HUGE_PAGE - 1) / HUGE_PAGE * HUGE_PAGE;
+            data_ = ::mmap(nullptr, mapped_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+            huge_ = data_ != MAP_FAILED;
+        }
+        if (!huge_) {
+            mapped_ = (bytes + 4095) / 4096 * 4096;
+            data_ = ::mmap(nullptr, mapped_, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (data_ == MAP_FAILED) {
+                data_ = nullptr;
+                throw std::runtime_error(std::string("[HOSTMEM] Cannot map host buffer: ") + std::strerror(errno));
+            }
+            if (hugepages) ::madvise(data_, mapped_, MADV_HUGEPAGE);
+        }
+
+        // Set the policy before the first touch below faults the pages in;
+        // a failure (no NUMA, node offline) only costs locality
+        if (numa_node >= 0 && numa_node < (int)(8 * sizeof(unsigned long))) {
+            unsigned long mask = 1UL << numa_node;
+            ::syscall(SYS_mbind, data_, mapped_, MPOL_PREFERRED_NODE, &mask, 8 * sizeof(mask), 0);
+        }
+        std::memset(data_, 0, mapped_);
+    }
+
+    HostBuffer::~HostBuffer() {
+        if (data_) ::munmap(data_, mapped_);
+    }
+
+    HostBuffer::HostBuffer(HostBuffer&& other) noexcept {
+        *this = std::move(other);
+    }
+
+    HostBuffer& HostBuffer::operator=(HostBuffer&& other) noexcept {
+        if (this != &other) {
+            if (data_) ::munmap(data_, mapped_);
+            data_ = other.data_;
+            size_ = other.size_;
+            mapped_ = other.mapped_;
+            huge_ = other.huge_;
+            other.data_ = nullptr;
+            other.size_ = other.mapped_ = 0;
+        }
+        return *this;
+    }
+
+} // namespace swaie
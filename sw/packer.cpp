@@ -0,0 +1,79 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/packer.h"
+#include <algorithm>
+
+namespace swaie {
+
+    size_t port_words(size_t num_couples) {
+        return ((num_couples + NUM_INPUT_PORTS - 1) / NUM_INPUT_PORTS) * COUPLE_WORDS;
+    }
+
+    // Bases per 64-bit lane of a port word
+    const int LANE_BASES = 64 / BITS_PER_CHAR;
+    static_assert(N_ELEM_BLOCK % LANE_BASES == 0, "port words hold whole 64-bit lanes");
+
+    // Words are assembled 64 bits at a time from the byte codes rather than
+    // one ap_uint range per base
+    void pack_couple(SequenceView target, SequenceView database, input_t* dst) {
+        for (size_t i = 0; i < COUPLE_WORDS; i++) {
+            input_t word = 0;
+            for (int lane = 0; lane < N_ELEM_BLOCK / LANE_BASES; lane++) {
+                uint64_t bits = 0;
+                for (int j = 0; j < LANE_BASES; j++) {
+                    size_t k = i * N_ELEM_BLOCK + lane * LANE_BASES + j;
+                    uint64_t base = 0;
+                    if (k < MAX_DIM) base = (k < target.size()) ? target[k] : TARGET_PAD;
+                    else if (k < 2 * MAX_DIM) base = (k - MAX_DIM < database.size()) ? database[k - MAX_DIM] : DATABASE_PAD;
+                    bits |= base << (j * BITS_PER_CHAR);
+                }
+                word.range(lane * 64 + 63, lane * 64) = bits;
+            }
+            dst[i] = word;
+        }
+    }
+
+    void unpack_couple(const input_t* src, uint8_t* target, uint8_t* database) {
+        std::fill(target, target + UNPACKED_LENGTH, TARGET_PAD);
+        std::fill(database, database + UNPACKED_LENGTH, DATABASE_PAD);
+        for (size_t k = 0; k < SEQ_SIZE; k++) {
+            const input_t& t = src[k / N_ELEM_BLOCK];
+            const input_t& d = src[(k + MAX_DIM) / N_ELEM_BLOCK];
+            size_t tj = k % N_ELEM_BLOCK, dj = (k + MAX_DIM) % N_ELEM_BLOCK;
+            target[k] = (uint8_t)alphabet_datatype(t.range((tj+1)*BITS_PER_CHAR-1, tj*BITS_PER_CHAR));
+            database[k] = (uint8_t)alphabet_datatype(d.range((dj+1)*BITS_PER_CHAR-1, dj*BITS_PER_CHAR));
+        }
+    }
+
+    void pack_striped(const SequenceBatch& target, const SequenceBatch& database,
+        size_t first, size_t count, input_t* const ports[NUM_INPUT_PORTS]) {
+
+        for (size_t n = 0; n < count; n++) {
+            input_t* dst = ports[n % NUM_INPUT_PORTS] + (n / NUM_INPUT_PORTS) * COUPLE_WORDS;
+            pack_couple(target[first + n], database[first + n], dst);
+        }
+    }
+
+} // namespace swaie
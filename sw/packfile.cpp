@@ -0,0 +1,248 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/packfile.h"
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace swaie {
+
+    const char PACK_MAGIC[8] = {'S', 'W', 'A', 'I', 'E', 'P', 'K', '\0'};
+    const char PACK_ENCODING[32] = "ACGT=0123 pad=4/5";
+
+    static size_t align_up(size_t bytes) {
+        return (bytes + PACK_ALIGNMENT - 1) / PACK_ALIGNMENT * PACK_ALIGNMENT;
+    }
+
+    static void write_at(int fd, const void* data, size_t bytes, size_t offset, const std::string& path) {
+        const char* p = static_cast<const char*>(data);
+        while (bytes > 0) {
+            ssize_t n = ::pwrite(fd, p, bytes, offset);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) throw std::runtime_error("[SWPACK] Cannot write " + path + ": " + std::strerror(errno));
+            p += n;
+            offset += n;
+            bytes -= n;
+        }
+    }
+
+    static PackHeader expected_header() {
+        PackHeader h;
+        std::memset(&h, 0, sizeof(h));
+        std::memcpy(h.magic, PACK_MAGIC, sizeof(h.magic));
+        std::memcpy(h.encoding, PACK_ENCODING, sizeof(h.encoding));
+        h.version = PACK_VERSION;
+        h.alignment = PACK_ALIGNMENT;
+        h.seq_size = SEQ_SIZE;
+        h.max_dim = MAX_DIM;
+        h.bits_per_char = BITS_PER_CHAR;
+        h.port_width = PORT_WIDTH;
+        h.couple_words = COUPLE_WORDS;
+        h.input_ports = NUM_INPUT_PORTS;
+        h.run_pairs = INPUT_SIZE;
+        h.port_stride = align_up(port_words(INPUT_SIZE) * sizeof(input_t));
+        h.payload_offset = PACK_ALIGNMENT;
+        return h;
+    }
+
+    PackWriter::PackWriter(const std::string& path) : path_(path), header_(expected_header()) {
+        fd_ = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd_ < 0) throw std::runtime_error("[SWPACK] Cannot create " + path + ": " + std::strerror(errno));
+        image_.assign(NUM_INPUT_PORTS, std::vector<input_t>(header_.port_stride / sizeof(input_t)));
+        offset_ = header_.payload_offset;
+    }
+
+    PackWriter::~PackWriter() {
+        if (fd_ >= 0) ::close(fd_);
+    }
+
+    void PackWriter::add(const Batch& batch, const std::vector<RecordInfo>& info) {
+        for (size_t n = 0; n < batch.size(); n++) {
+            pending_.target.push_back(batch.target[n], batch.target.id(n));
+            pending_.database.push_back(batch.database[n], batch.database.id(n));
+            index_.push_back({(uint32_t)info[2*n].length, (uint32_t)info[2*n + 1].length, names_.size()});
+            names_.append(info[2*n].name).push_back('\0');
+            names_.append(info[2*n + 1].name).push_back('\0');
+            if (pending_.size() == INPUT_SIZE) flush_run();
+        }
+    }
+
+    void PackWriter::flush_run() {
+        input_t* ports[NUM_INPUT_PORTS];
+        for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+            std::fill(image_[p].begin(), image_[p].end(), input_t(0));
+            ports[p] = image_[p].data();
+        }
+        pack_striped(pending_.target, pending_.database, 0, pending_.size(), ports);
+        for (int p = 0; p < NUM_INPUT_PORTS; p++) {
+            write_at(fd_, image_[p].data(), header_.port_stride, offset_, path_);
+            offset_ += header_.port_stride;
+        }
+        header_.num_runs++;
+        pending_ = Batch();
+    }
+
+    size_t PackWriter::finish() {
+        if (pending_.size() > 0) flush_run();
+
+        header_.num_pairs = index_.size();
+        header_.index_offset = offset_;
+        header_.names_offset = offset_ + index_.size() * sizeof(PackIndexEntry);
+        header_.names_bytes = names_.size();
+        write_at(fd_, index_.data(), index_.size() * sizeof(PackIndexEntry), header_.index_offset, path_);
+        write_at(fd_, names_.data(), names_.size(), header_.names_offset, path_);
+        // Header last: an interrupted write leaves a file that fails validation
+        write_at(fd_, &header_, sizeof(header_), 0, path_);
+
+        if (::fsync(fd_) < 0) throw std::runtime_error("[SWPACK] Cannot sync " + path_ + ": " + std::strerror(errno));
+        ::close(fd_);
+        fd_ = -1;
+        return header_.num_pairs;
+    }
+
+    size_t write_packfile(const std::string& path, SequenceReader& reader) {
+        PackWriter writer(path);
+        for (;;) {
+            Batch batch;
+            std::vector<RecordInfo> info;
+            if (reader.read_pairs(batch, INPUT_SIZE, &info) == 0) break;
+            writer.add(batch, info);
+        }
+        return writer.finish();
+    }
+
+    bool is_packfile(const std::string& path) {
+        char magic[sizeof(PACK_MAGIC)];
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) return false;
+        bool match = ::read(fd, magic, sizeof(magic)) == (ssize_t)sizeof(magic) &&
+            std::memcmp(magic, PACK_MAGIC, sizeof(magic)) == 0;
+        ::close(fd);
+        return match;
+    }
+
+    PackFile::PackFile(const std::string& path) {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        struct stat st;
+        if (fd < 0 || ::fstat(fd, &st) < 0) {
+            int error = errno;
+            if (fd >= 0) ::close(fd);
+            throw std::runtime_error("[SWPACK] Cannot open " + path + ": " + std::strerror(error));
+        }
+        bytes_ = st.st_size;
+        if (bytes_ < PACK_ALIGNMENT) {
+            ::close(fd);
+            throw std::runtime_error("[SWPACK] " + path + " is not a pack file");
+        }
+
+        // Private and writable: nothing is written, but XRT pins user pointers
+        // for write, and a private mapping keeps that from touching the file
+        void* map = ::mmap(nullptr, bytes_, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        ::close(fd);
+        if (map == MAP_FAILED) throw std::runtime_error("[SWPACK] Cannot map " + path + ": " + std::strerror(errno));
+        base_ = static_cast<char*>(map);
+        ::madvise(base_, bytes_, MADV_SEQUENTIAL);
+        header_ = reinterpret_cast<const PackHeader*>(base_);
+
+        PackHeader want = expected_header();
+        const PackHeader& h = *header_;
+        std::string error;
+        if (std::memcmp(h.magic, PACK_MAGIC, sizeof(h.magic)) != 0) error = "is not a pack file";
+        else if (h.version != PACK_VERSION) error = "has unsupported version " + std::to_string(h.version);
+        else if (h.seq_size != want.seq_size || h.max_dim != want.max_dim || h.bits_per_char != want.bits_per_char ||
+            h.port_width != want.port_width || h.couple_words != want.couple_words || h.input_ports != want.input_ports ||
+            h.run_pairs != want.run_pairs || h.alignment != want.alignment || h.port_stride != want.port_stride ||
+            std::memcmp(h.encoding, want.encoding, sizeof(h.encoding)) != 0) {
+            error = "was packed for another geometry (SEQ_SIZE " + std::to_string(h.seq_size) +
+                ", " + std::to_string(h.input_ports) + " ports, " + std::to_string(h.run_pairs) + " pairs per run)";
+        }
+        else if (h.num_runs * NUM_INPUT_PORTS * h.port_stride + h.payload_offset != h.index_offset ||
+            h.num_pairs > h.num_runs * INPUT_SIZE ||
+            h.names_offset != h.index_offset + h.num_pairs * sizeof(PackIndexEntry) ||
+            h.names_offset + h.names_bytes > bytes_) {
+            error = "is truncated or corrupt";
+        }
+        if (!error.empty()) {
+            ::munmap(base_, bytes_);
+            throw std::runtime_error("[SWPACK] " + path + " " + error);
+        }
+
+        index_ = reinterpret_cast<const PackIndexEntry*>(base_ + h.index_offset);
+        names_ = base_ + h.names_offset;
+    }
+
+    PackFile::~PackFile() {
+        ::munmap(base_, bytes_);
+    }
+
+    size_t PackFile::run_pairs(size_t run) const {
+        return std::min<size_t>(INPUT_SIZE, size() - run * INPUT_SIZE);
+    }
+
+    input_t* PackFile::port(size_t run, int p) const {
+        return reinterpret_cast<input_t*>(base_ + header_->payload_offset + (run * NUM_INPUT_PORTS + p) * header_->port_stride);
+    }
+
+    std::string PackFile::target_name(size_t pair) const {
+        return std::string(names_ + index_[pair].name_offset);
+    }
+
+    std::string PackFile::database_name(size_t pair) const {
+        const char* target = names_ + index_[pair].name_offset;
+        return std::string(target + std::strlen(target) + 1);
+    }
+
+    Batch PackFile::batch(size_t first, size_t count) const {
+        Batch b;
+        b.target.reserve(count, count * UNPACKED_LENGTH);
+        b.database.reserve(count, count * UNPACKED_LENGTH);
+        for (size_t n = 0; n < count; n++) {
+            size_t pair = first + n;
+            size_t run = pair / INPUT_SIZE, slot = pair % INPUT_SIZE;
+            const input_t* src = port(run, slot % NUM_INPUT_PORTS) + (slot / NUM_INPUT_PORTS) * COUPLE_WORDS;
+            uint8_t* target = b.target.append(UNPACKED_LENGTH, 2 * pair);
+            unpack_couple(src, target, b.database.append(UNPACKED_LENGTH, 2 * pair + 1));
+        }
+        return b;
+    }
+
+    // Engines without a zero-copy path align the file in preferred-size batches
+    Scores Backend::align_packed(const PackFile& pack) {
+        size_t step = preferred_batch() ? preferred_batch() : INPUT_SIZE;
+        Scores scores;
+        scores.reserve(pack.size());
+        for (size_t first = 0; first < pack.size(); first += step) {
+            Scores part = align(pack.batch(first, std::min(step, pack.size() - first)));
+            scores.insert(scores.end(), part.begin(), part.end());
+        }
+        return scores;
+    }
+
+} // namespace swaie
@@ -0,0 +1,202 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/prefilter.h"
+#include "../common/trace.h"
+#include <algorithm>
+#include <cstdint>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace swaie {
+
+    static_assert(MATCH > 0 && MISMATCH < 0 && GAP_OPENING < 0, "prefilter bound assumes positive matches and negative errors");
+    // Every gap is costed as a mismatch, which only raises the bound while a
+    // gap costs at least as much
+    static_assert(GAP_OPENING <= MISMATCH, "prefilter bound assumes a gap costs no less than a mismatch");
+    // Bases are folded to 2 bits (code & 3) before counting. Folding can only
+    // merge distinct j-mers, which raises the shared counts, so the bound stays
+    // sound; ACGT keep their own codes and the 4-mer table fits in L1.
+    const unsigned FOLD_BITS = 2;
+    static_assert(PREFILTER_MAX_K * FOLD_BITS <= 16, "j-mer codes must fit a 16-bit count table");
+    static_assert(SEQ_SIZE <= UINT16_MAX, "j-mer counts must not wrap");
+
+    // Per-thread j-mer count tables, left zeroed between pairs. Counts are
+    // 16-bit: a low-complexity read repeats one j-mer up to SEQ_SIZE times.
+    struct KmerTables {
+        std::vector<uint16_t> count[PREFILTER_MAX_K];
+
+        explicit KmerTables(unsigned k) {
+            for (unsigned j = 0; j < k; j++) count[j].assign(size_t(1) << (FOLD_BITS * (j + 1)), 0);
+        }
+    };
+
+    // Shared j-mer counts for j = 1..K, K fixed so the per-base loops unroll
+    template <unsigned K>
+    static void count_shared(const uint8_t* target, size_t n, const uint8_t* database, size_t m,
+        KmerTables& tables, int* shared) {
+        uint16_t* count[K];
+        for (unsigned j = 0; j < K; j++) count[j] = tables.count[j].data();
+        const uint32_t mask = (1u << (FOLD_BITS * K)) - 1;
+
+        // A j-mer ends at p >= j - 1; codes before that are zero-padded
+        uint32_t code = 0;
+        for (size_t p = 0; p < n; p++) {
+            code = ((code << FOLD_BITS) | target[p]) & mask;
+            for (unsigned j = 0; j < K; j++) {
+                if (p >= j) count[j][code & ((1u << (FOLD_BITS * (j + 1))) - 1)]++;
+            }
+        }
+        code = 0;
+        for (size_t p = 0; p < m; p++) {
+            code = ((code << FOLD_BITS) | database[p]) & mask;
+            for (unsigned j = 0; j < K; j++) {
+                if (p < j) continue;
+                uint16_t& c = count[j][code & ((1u << (FOLD_BITS * (j + 1))) - 1)];
+                shared[j] += (c != 0);
+                c -= (c != 0);
+            }
+        }
+        code = 0;
+        for (size_t p = 0; p < n; p++) {
+            code = ((code << FOLD_BITS) | target[p]) & mask;
+            for (unsigned j = 0; j < K; j++) count[j][code & ((1u << (FOLD_BITS * (j + 1))) - 1)] = 0;
+        }
+    }
+
+    static int32_t upper_bound(SequenceView target, SequenceView database, unsigned k, KmerTables& tables) {
+        size_t n = std::min<size_t>(SEQ_SIZE, target.size());
+        size_t m = std::min<size_t>(SEQ_SIZE, database.size());
+        uint8_t t[SEQ_SIZE], d[SEQ_SIZE];
+        for (size_t p = 0; p < n; p++) t[p] = target[p] & 3;
+        for (size_t p = 0; p < m; p++) d[p] = database[p] & 3;
+
+        int shared[PREFILTER_MAX_K] = {};
+        switch (k) {
+            case 1: count_shared<1>(t, n, d, m, tables, shared); break;
+            case 2: count_shared<2>(t, n, d, m, tables, shared); break;
+            case 3: count_shared<3>(t, n, d, m, tables, shared); break;
+            case 4: count_shared<4>(t, n, d, m, tables, shared); break;
+            case 5: count_shared<5>(t, n, d, m, tables, shared); break;
+            case 6: count_shared<6>(t, n, d, m, tables, shared); break;
+            case 7: count_shared<7>(t, n, d, m, tables, shared); break;
+            default: count_shared<8>(t, n, d, m, tables, shared); break;
+        }
+
+        // Capacity: matches and mismatches take one base of each sequence.
+        // Past the X where the 1-mer count or capacity caps M, more X only costs.
+        const int capacity = (int)(n + m) / 2;
+        int32_t best = 0;
+        for (int mismatches = 0; mismatches <= capacity; mismatches++) {
+            int matches = std::min(shared[0], capacity - mismatches);
+            bool capped = true;
+            for (unsigned j = 1; j < k; j++) {
+                int runs_bound = shared[j] + (mismatches + 1) * (int)j;
+                if (runs_bound < matches) { matches = runs_bound; capped = false; }
+            }
+            best = std::max(best, matches * MATCH + mismatches * MISMATCH);
+            if (capped) break;
+        }
+        return best;
+    }
+
+    static void check_k(unsigned k) {
+        if (k < 1 || k > PREFILTER_MAX_K) {
+            throw std::runtime_error("[PREFILTER] k must be between 1 and " + std::to_string(PREFILTER_MAX_K));
+        }
+    }
+
+    int32_t score_upper_bound(SequenceView target, SequenceView database, unsigned k) {
+        check_k(k);
+        KmerTables tables(k);
+        return upper_bound(target, database, k, tables);
+    }
+
+    class PrefilteredBackend : public Backend {
+    public:
+        PrefilteredBackend(std::unique_ptr<Backend> inner, int32_t min_score, unsigned k, unsigned threads)
+            : inner_(std::move(inner)), min_score_(min_score), k_(k),
+              threads_(threads ? threads : std::max(1u, std::thread::hardware_concurrency())) {
+            check_k(k);
+        }
+
+        ~PrefilteredBackend() override {
+            std::cout << "[PREFILTER] " << rejected_ << "/" << seen_ << " pairs cannot reach score "
+                << min_score_ << " (" << (seen_ ? 100.0 * rejected_ / seen_ : 0.0) << "%)." << std::endl;
+        }
+
+        std::string name() const override { return "prefiltered(" + inner_->name() + ")"; }
+
+        size_t preferred_batch() const override { return inner_->preferred_batch(); }
+
+        Scores align(const Batch& batch) override {
+            std::vector<uint8_t> keep(batch.size());
+            {
+                trace::Span span("prefilter");
+                unsigned workers = (unsigned)std::min<size_t>(threads_, (batch.size() + 255) / 256);
+                auto run = [&](unsigned w) {
+                    KmerTables tables(k_);
+                    for (size_t i = w; i < batch.size(); i += workers) {
+                        keep[i] = upper_bound(batch.target[i], batch.database[i], k_, tables) >= min_score_;
+                    }
+                };
+                std::vector<std::thread> pool;
+                for (unsigned w = 1; w < workers; w++) pool.emplace_back(run, w);
+                if (workers > 0) run(0);
+                for (std::thread& t : pool) t.join();
+            }
+
+            Batch kept;
+            for (size_t i = 0; i < batch.size(); i++) {
+                if (!keep[i]) continue;
+                kept.target.push_back(batch.target[i], batch.target.id(i));
+                kept.database.push_back(batch.database[i], batch.database.id(i));
+            }
+            seen_ += batch.size();
+            rejected_ += batch.size() - kept.size();
+
+            Scores scores(batch.size(), FILTERED_SCORE);
+            if (kept.size() == 0) return scores;
+            Scores computed = inner_->align(kept);
+            for (size_t i = 0, u = 0; i < batch.size(); i++) {
+                if (keep[i]) scores[i] = computed[u++];
+            }
+            return scores;
+        }
+
+    private:
+        std::unique_ptr<Backend> inner_;
+        int32_t min_score_;
+        unsigned k_;
+        unsigned threads_;
+        uint64_t seen_ = 0;
+        uint64_t rejected_ = 0;
+    };
+
+    std::unique_ptr<Backend> make_prefiltered_backend(std::unique_ptr<Backend> inner, int32_t min_score, unsigned k, unsigned threads) {
+        return std::make_unique<PrefilteredBackend>(std::move(inner), min_score, k, threads);
+    }
+
+} // namespace swaie
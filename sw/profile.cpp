@@ -0,0 +1,83 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/profile.h"
+#include <algorithm>
+#include <iomanip>
+
+namespace swaie {
+
+    TileProfile& TileProfile::operator+=(const TileProfile& other) {
+        pairs += other.pairs;
+        input_cycles += other.input_cycles;
+        compute_cycles += other.compute_cycles;
+        output_cycles += other.output_cycles;
+        max_input_cycles = std::max(max_input_cycles, other.max_input_cycles);
+        return *this;
+    }
+
+    std::vector<TileProfile> decode_profile(const int32_t* words, size_t stride) {
+        auto word = [&](int t, int k) { return (uint64_t)(uint32_t)words[(t * PROFILE_WORDS + k) * stride]; };
+
+        std::vector<TileProfile> tiles(PARTITION_TILES);
+        for (int t = 0; t < PARTITION_TILES; t++) {
+            tiles[t].pairs = word(t, 0);
+            tiles[t].input_cycles = word(t, 1) | (word(t, 2) << 32);
+            tiles[t].compute_cycles = word(t, 3) | (word(t, 4) << 32);
+            tiles[t].output_cycles = word(t, 5) | (word(t, 6) << 32);
+            tiles[t].max_input_cycles = (uint32_t)word(t, 7);
+        }
+        return tiles;
+    }
+
+    void print_profile(std::ostream& os, const std::vector<TileProfile>& tiles) {
+        TileProfile sum;
+        std::ios state(nullptr);
+        state.copyfmt(os);
+
+        os << "[PROFILE] tile     pairs  in/pair  dp/pair out/pair max_in   input%     dp%   output%" << std::endl;
+        os << std::fixed;
+        for (size_t t = 0; t < tiles.size(); t++) {
+            const TileProfile& p = tiles[t];
+            sum += p;
+            double pairs = std::max<uint64_t>(p.pairs, 1), total = std::max<uint64_t>(p.total_cycles(), 1);
+            os << "[PROFILE] " << std::setw(4) << t << std::setw(10) << p.pairs << std::setprecision(0)
+                << std::setw(9) << p.input_cycles / pairs << std::setw(9) << p.compute_cycles / pairs
+                << std::setw(9) << p.output_cycles / pairs << std::setw(7) << p.max_input_cycles << std::setprecision(1)
+                << std::setw(9) << 100.0 * p.input_cycles / total << std::setw(8) << 100.0 * p.compute_cycles / total
+                << std::setw(10) << 100.0 * p.output_cycles / total << std::endl;
+        }
+
+        double total = std::max<uint64_t>(sum.total_cycles(), 1);
+        double input = sum.input_cycles / total, compute = sum.compute_cycles / total, output = sum.output_cycles / total;
+        os << std::setprecision(1) << "[PROFILE] array: " << 100.0 * compute << "% DP, "
+            << 100.0 * input << "% input stall, " << 100.0 * output << "% output stall -> ";
+        if (compute >= input && compute >= output) os << "compute bound" << std::endl;
+        else if (input >= output) os << "PLIO feed bound (data_reader / input PLIOs)" << std::endl;
+        else os << "output bound (output_sink backpressure)" << std::endl;
+
+        os.copyfmt(state);
+    }
+
+} // namespace swaie
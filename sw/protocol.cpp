@@ -0,0 +1,146 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/protocol.h"
+#include <cerrno>
+#include <unistd.h>
+#include <sys/socket.h>
+
+namespace swaie {
+
+    bool read_full(int fd, void* data, size_t bytes) {
+        char* p = static_cast<char*>(data);
+        while (bytes > 0) {
+            ssize_t n = ::read(fd, p, bytes);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            p += n;
+            bytes -= n;
+        }
+        return true;
+    }
+
+    bool write_full(int fd, const void* data, size_t bytes) {
+        const char* p = static_cast<const char*>(data);
+        while (bytes > 0) {
+            ssize_t n = ::send(fd, p, bytes, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) return false;
+            p += n;
+            bytes -= n;
+        }
+        return true;
+    }
+
+    std::string check_request(const Batch& batch) {
+        if (batch.size() > MAX_REQUEST_PAIRS) {
+            return "a request holds at most " + std::to_string(MAX_REQUEST_PAIRS) + " pairs";
+        }
+        if (batch.size() == 0) return "";
+
+        size_t seq_len = batch.target[0].size();
+        if (seq_len < SEQ_SIZE || seq_len > MAX_DIM) {
+            return "sequences must hold " + std::to_string(SEQ_SIZE) + " to " + std::to_string(MAX_DIM) +
+                " bases, got " + std::to_string(seq_len);
+        }
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (batch.target[i].size() != seq_len || batch.database[i].size() != seq_len) {
+                return "pair " + std::to_string(i) + " is not " + std::to_string(seq_len) +
+                    " bases long like the first target";
+            }
+        }
+        return "";
+    }
+
+    bool send_request(int fd, uint64_t request_id, const Batch& batch) {
+        uint32_t seq_len = batch.size() ? (uint32_t)batch.target[0].size() : 0;
+
+        RequestHeader header = {REQUEST_MAGIC, PROTOCOL_VERSION, 0, (uint32_t)batch.size(), seq_len, request_id};
+        if (!write_full(fd, &header, sizeof(header))) return false;
+
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (!write_full(fd, batch.target[i].data(), seq_len) ||
+                !write_full(fd, batch.database[i].data(), seq_len)) return false;
+        }
+        return true;
+    }
+
+    bool recv_request(int fd, RequestHeader& header, Batch& batch, std::string& error) {
+        if (!read_full(fd, &header, sizeof(header))) return false;
+        if (header.magic != REQUEST_MAGIC || header.num_pairs > MAX_REQUEST_PAIRS || header.seq_len > MAX_REQUEST_SEQ_LEN) return false;
+
+        error.clear();
+        if (header.version != PROTOCOL_VERSION) {
+            error = "unsupported protocol version " + std::to_string(header.version);
+        } else if (header.num_pairs > 0 && (header.seq_len < SEQ_SIZE || header.seq_len > MAX_DIM)) {
+            error = "sequences must hold " + std::to_string(SEQ_SIZE) + " to " + std::to_string(MAX_DIM) +
+                " bases, got " + std::to_string(header.seq_len);
+        }
+
+        batch = Batch();
+        if (!error.empty()) {
+            // Consumed so the connection stays in step for the next request
+            std::vector<uint8_t> discard(2 * (size_t)header.seq_len);
+            for (uint32_t i = 0; i < header.num_pairs; i++) {
+                if (!read_full(fd, discard.data(), discard.size())) return false;
+            }
+            return true;
+        }
+
+        batch.target.reserve(header.num_pairs, (size_t)header.num_pairs * header.seq_len);
+        batch.database.reserve(header.num_pairs, (size_t)header.num_pairs * header.seq_len);
+
+        std::vector<uint8_t> payload(2 * (size_t)header.seq_len);
+        for (uint32_t i = 0; i < header.num_pairs; i++) {
+            if (!read_full(fd, payload.data(), payload.size())) return false;
+            std::memcpy(batch.target.append(header.seq_len, 2 * i), payload.data(), header.seq_len);
+            std::memcpy(batch.database.append(header.seq_len, 2 * i + 1), payload.data() + header.seq_len, header.seq_len);
+        }
+        return true;
+    }
+
+    bool send_response(int fd, uint64_t request_id, const Scores& scores) {
+        ResponseHeader header = {RESPONSE_MAGIC, STATUS_OK, (uint32_t)scores.size(), 0, request_id};
+        return write_full(fd, &header, sizeof(header)) &&
+            write_full(fd, scores.data(), scores.size() * sizeof(int32_t));
+    }
+
+    bool send_error(int fd, uint64_t request_id, ResponseStatus status, const std::string& message) {
+        ResponseHeader header = {RESPONSE_MAGIC, status, 0, (uint32_t)message.size(), request_id};
+        return write_full(fd, &header, sizeof(header)) && write_full(fd, message.data(), message.size());
+    }
+
+    bool recv_response(int fd, ResponseHeader& header, Scores& scores, std::string& error) {
+        if (!read_full(fd, &header, sizeof(header)) || header.magic != RESPONSE_MAGIC) return false;
+        if (header.status != STATUS_OK) {
+            if (header.message_bytes > MAX_MESSAGE_BYTES) return false;
+            error.assign(header.message_bytes, '\0');
+            return read_full(fd, &error[0], header.message_bytes);
+        }
+        if (header.num_pairs > MAX_REQUEST_PAIRS) return false;
+        scores.resize(header.num_pairs);
+        return read_full(fd, scores.data(), scores.size() * sizeof(int32_t));
+    }
+
+} // namespace swaie
@@ -0,0 +1,271 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/result_writer.h"
+#include "../common/trace.h"
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+
+namespace swaie {
+
+    // O_DIRECT transfers must be block aligned in offset, length and memory
+    static const size_t DIRECT_ALIGNMENT = 4096;
+
+    static std::runtime_error io_error(const std::string& what, const std::string& path) {
+        return std::runtime_error("[RESULT WRITER] " + what + " " + path + ": " + std::strerror(errno));
+    }
+
+    ResultFormat result_format_for(const std::string& path) {
+        const std::string suffix = ".tsv";
+        bool tsv = path.size() >= suffix.size() && path.compare(path.size() - suffix.size(), suffix.size(), suffix) == 0;
+        return tsv ? ResultFormat::Tsv : ResultFormat::Binary;
+    }
+
+    ResultWriter::ResultWriter(const std::string& path, ResultFormat format, WriterOptions options)
+        : path_(path), format_(format), options_(options) {
+        options_.buffer_bytes = std::max(DIRECT_ALIGNMENT, options_.buffer_bytes / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT);
+        options_.queued_chunks = std::max<size_t>(1, options_.queued_chunks);
+        chunk_records_ = std::max<size_t>(1, options_.buffer_bytes / sizeof(ResultRecord));
+
+        if (path == "-") {
+            fd_ = STDOUT_FILENO;
+        } else {
+            int flags = O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC;
+            if (options_.direct) {
+                fd_ = ::open(path.c_str(), flags | O_DIRECT, 0644);
+                direct_ = fd_ >= 0;
+                // e.g. tmpfs: fall back to buffered writes
+                if (fd_ < 0 && errno != EINVAL) throw io_error("Cannot create", path);
+            }
+            if (fd_ < 0) fd_ = ::open(path.c_str(), flags, 0644);
+            if (fd_ < 0) throw io_error("Cannot create", path);
+        }
+
+        buffer_ = HostBuffer(options_.buffer_bytes, -1, false);
+        current_.records.reserve(chunk_records_);
+        thread_ = std::thread(&ResultWriter::io_thread, this);
+    }
+
+    ResultWriter::~ResultWriter() {
+        try {
+            close();
+        } catch (const std::exception& e) {
+            std::cerr << e.what() << std::endl;
+        }
+    }
+
+    void ResultWriter::check() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (error_) std::rethrow_exception(error_);
+    }
+
+    void ResultWriter::write(uint64_t first_id, const Scores& scores, const std::vector<RecordInfo>* info) {
+        write(first_id, scores.data(), scores.size(), info);
+    }
+
+    void ResultWriter::write(uint64_t first_id, const int32_t* scores, size_t count, const std::vector<RecordInfo>* info) {
+        if (closed_) throw std::runtime_error("[RESULT WRITER] Write after close to " + path_);
+        if (first_write_) {
+            named_ = info != nullptr;
+            first_write_ = false;
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            current_.records.push_back({first_id + i, scores[i]});
+            if (named_) {
+                bool have = info && info->size() >= 2 * (i + 1);
+                current_.names.push_back(have ? (*info)[2 * i].name : "");
+                current_.names.push_back(have ? (*info)[2 * i + 1].name : "");
+            }
+            if (current_.records.size() == chunk_records_) {
+                push(std::move(current_));
+                current_ = Chunk();
+                current_.records.reserve(chunk_records_);
+            }
+        }
+    }
+
+    void ResultWriter::push(Chunk chunk) {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (queue_.size() >= options_.queued_chunks && !error_) {
+            auto start = std::chrono::steady_clock::now();
+            not_full_.wait(lock, [this] { return queue_.size() < options_.queued_chunks || error_; });
+            stats_.stalls++;
+            stats_.stall_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        }
+        if (error_) std::rethrow_exception(error_);
+        stats_.records += chunk.records.size();
+        queue_.push_back(std::move(chunk));
+        lock.unlock();
+        not_empty_.notify_one();
+    }
+
+    void ResultWriter::close() {
+        if (closed_) return;
+        closed_ = true;
+
+        std::exception_ptr pending;
+        try {
+            if (!current_.records.empty()) push(std::move(current_));
+        } catch (...) {
+            pending = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            done_ = true;
+        }
+        not_empty_.notify_one();
+        thread_.join();
+
+        if (fd_ != STDOUT_FILENO) ::close(fd_);
+        fd_ = -1;
+        if (pending) std::rethrow_exception(pending);
+        check();
+    }
+
+    void ResultWriter::io_thread() {
+        trace::set_thread_name("result writer");
+        try {
+            if (format_ == ResultFormat::Binary) {
+                ResultHeader header = {};
+                std::memcpy(header.magic, RESULT_MAGIC, sizeof(header.magic));
+                header.version = RESULT_VERSION;
+                header.record_bytes = sizeof(ResultRecord);
+                emit(reinterpret_cast<const char*>(&header), sizeof(header));
+            }
+
+            bool header_line = format_ == ResultFormat::Tsv;
+            for (;;) {
+                Chunk chunk;
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    not_empty_.wait(lock, [this] { return !queue_.empty() || done_; });
+                    if (queue_.empty()) break;
+                    chunk = std::move(queue_.front());
+                    queue_.pop_front();
+                }
+                not_full_.notify_one();
+
+                trace::Span span("write_results");
+                if (format_ == ResultFormat::Binary) {
+                    emit(reinterpret_cast<const char*>(chunk.records.data()), chunk.records.size() * sizeof(ResultRecord));
+                    continue;
+                }
+
+                bool named = !chunk.names.empty();
+                if (header_line) {
+                    const std::string columns = named ? "pair_id\tscore\ttarget\tdatabase\n" : "pair_id\tscore\n";
+                    emit(columns.data(), columns.size());
+                    header_line = false;
+                }
+                char line[64];
+                for (size_t i = 0; i < chunk.records.size(); i++) {
+                    // At most 20 digits for the id and 11 characters for the score
+                    char* end = std::to_chars(line, line + 20, chunk.records[i].pair_id).ptr;
+                    *end++ = '\t';
+                    end = std::to_chars(end, end + 11, chunk.records[i].score).ptr;
+                    if (named) {
+                        emit(line, end - line);
+                        for (int n = 0; n < 2; n++) {
+                            emit("\t", 1);
+                            emit(chunk.names[2 * i + n].data(), chunk.names[2 * i + n].size());
+                        }
+                        end = line;
+                    }
+                    *end++ = '\n';
+                    emit(line, end - line);
+                }
+            }
+            flush(true);
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            error_ = std::current_exception();
+            queue_.clear();
+        }
+        not_full_.notify_all();
+    }
+
+    void ResultWriter::emit(const char* data, size_t bytes) {
+        char* buffer = static_cast<char*>(buffer_.data());
+        while (bytes > 0) {
+            size_t n = std::min(bytes, buffer_.size() - used_);
+            std::memcpy(buffer + used_, data, n);
+            used_ += n;
+            data += n;
+            bytes -= n;
+            if (used_ == buffer_.size()) flush(false);
+        }
+    }
+
+    // Writes the staging buffer; the last, partial block of an O_DIRECT file
+    // is padded out and the file cut back to its real length afterwards
+    void ResultWriter::flush(bool final) {
+        char* buffer = static_cast<char*>(buffer_.data());
+        uint64_t length = offset_ + used_;
+        size_t bytes = used_;
+        if (direct_ && bytes % DIRECT_ALIGNMENT) {
+            size_t padded = (bytes + DIRECT_ALIGNMENT - 1) / DIRECT_ALIGNMENT * DIRECT_ALIGNMENT;
+            std::memset(buffer + bytes, 0, padded - bytes);
+            bytes = padded;
+        }
+
+        for (size_t done = 0; done < bytes;) {
+            ssize_t n = ::write(fd_, buffer + done, bytes - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) throw io_error("Cannot write", path_);
+            done += n;
+        }
+        offset_ = length;
+        stats_.bytes = length;
+        used_ = 0;
+        if (!final || fd_ == STDOUT_FILENO) return;
+
+        // Direct files need a buffered descriptor for the unaligned fix-ups
+        int fd = fd_;
+        if (direct_) {
+            fd = ::open(path_.c_str(), O_WRONLY | O_CLOEXEC);
+            if (fd < 0) throw io_error("Cannot reopen", path_);
+            if (::ftruncate(fd, length) != 0) {
+                ::close(fd);
+                throw io_error("Cannot truncate", path_);
+            }
+        }
+        if (format_ == ResultFormat::Binary) {
+            uint64_t count = (length - sizeof(ResultHeader)) / sizeof(ResultRecord);
+            if (::pwrite(fd, &count, sizeof(count), offsetof(ResultHeader, num_records)) != sizeof(count)) {
+                if (fd != fd_) ::close(fd);
+                throw io_error("Cannot finalize", path_);
+            }
+        }
+        if (fd != fd_) ::close(fd);
+    }
+
+} // namespace swaie
@@ -0,0 +1,265 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/score_cache.h"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <unordered_map>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+namespace swaie {
+
+    const uint64_t CACHE_MAGIC = 0x4548434145494157ULL; // "WAIEACHE"
+    const uint32_t CACHE_VERSION = 2;
+
+    struct ScoreCache::Header {
+        uint64_t magic;
+        uint32_t version;
+        uint32_t reserved;
+        uint64_t signature;
+        uint64_t capacity;
+        uint64_t count;
+    };
+
+    struct ScoreCache::Entry {
+        uint64_t lo;
+        uint64_t hi;
+        int32_t score;
+        uint32_t used;
+    };
+
+    static inline uint64_t mix(uint64_t a, uint64_t b) {
+        __uint128_t r = (__uint128_t)a * b;
+        return (uint64_t)r ^ (uint64_t)(r >> 64);
+    }
+
+    // wyhash-style hash: 8 bytes per multiply, good enough spread for table
+    // indexing, and two seeds give an independent 128-bit fingerprint
+    static uint64_t hash_bytes(const uint8_t* data, size_t bytes, uint64_t seed) {
+        const uint64_t p0 = 0xa0761d6478bd642fULL, p1 = 0xe7037ed1a0b428dbULL;
+        uint64_t h = seed ^ p0;
+        size_t i = 0;
+        for (; i + 8 <= bytes; i += 8) {
+            uint64_t w;
+            std::memcpy(&w, data + i, 8);
+            h = mix(w ^ p1, h ^ p0);
+        }
+        uint64_t tail = 0;
+        std::memcpy(&tail, data + i, bytes - i);
+        return mix(mix(tail ^ p1, h ^ p0), bytes ^ p1);
+    }
+
+    // Geometry and scoring a cached score depends on
+    static uint64_t scoring_signature() {
+        const int32_t params[] = {SEQ_SIZE, MATCH, MISMATCH, GAP_OPENING, BITS_PER_CHAR};
+        return hash_bytes(reinterpret_cast<const uint8_t*>(params), sizeof(params), CACHE_MAGIC);
+    }
+
+    // Two bases per byte of the first SEQ_SIZE bases, zero beyond the end
+    static uint32_t pack_bases(SequenceView seq, uint8_t* dst) {
+        size_t length = std::min(seq.size(), (size_t)SEQ_SIZE);
+        for (size_t i = 0; i < length; i++) {
+            dst[i / 2] |= (uint8_t)((unsigned)seq[i] << (4 * (i & 1)));
+        }
+        return (uint32_t)length;
+    }
+
+    PairKey pair_key(SequenceView target, SequenceView database) {
+        static const uint64_t signature = scoring_signature();
+        const size_t half = (SEQ_SIZE + 1) / 2;
+
+        // Both sequences plus their lengths, so a short sequence does not
+        // collide with the same one padded by code 0
+        uint8_t packed[2 * half + 2 * sizeof(uint32_t)] = {};
+        uint32_t lengths[2] = {pack_bases(target, packed), pack_bases(database, packed + half)};
+        std::memcpy(packed + 2 * half, lengths, sizeof(lengths));
+
+        return {hash_bytes(packed, sizeof(packed), signature), hash_bytes(packed, sizeof(packed), ~signature)};
+    }
+
+    ScoreCache::ScoreCache(size_t capacity, const std::string& path) {
+        size_t slots = 1024;
+        while (slots < capacity) slots <<= 1;
+        mask_ = slots - 1;
+        mapped_bytes_ = sizeof(Header) + slots * sizeof(Entry);
+
+        if (path.empty()) {
+            heap_.assign((mapped_bytes_ + sizeof(uint64_t) - 1) / sizeof(uint64_t), 0);
+            header_ = reinterpret_cast<Header*>(heap_.data());
+        } else {
+            fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+            struct stat st;
+            if (fd_ < 0 || ::fstat(fd_, &st) < 0) {
+                int error = errno;
+                if (fd_ >= 0) ::close(fd_);
+                throw std::runtime_error("[SCORE CACHE] Cannot open " + path + ": " + std::strerror(error));
+            }
+            // A file of another size is truncated first so it comes back zeroed
+            bool resize = (size_t)st.st_size != mapped_bytes_;
+            if (resize && (::ftruncate(fd_, 0) < 0 || ::ftruncate(fd_, mapped_bytes_) < 0)) {
+                ::close(fd_);
+                throw std::runtime_error("[SCORE CACHE] Cannot size " + path + ": " + std::strerror(errno));
+            }
+            void* map = ::mmap(nullptr, mapped_bytes_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+            if (map == MAP_FAILED) {
+                ::close(fd_);
+                throw std::runtime_error("[SCORE CACHE] Cannot map " + path + ": " + std::strerror(errno));
+            }
+            header_ = static_cast<Header*>(map);
+        }
+        entries_ = reinterpret_cast<Entry*>(header_ + 1);
+
+        if (header_->magic != CACHE_MAGIC || header_->version != CACHE_VERSION ||
+            header_->signature != scoring_signature() || header_->capacity != slots) {
+            if (header_->magic == CACHE_MAGIC) {
+                std::cerr << "[SCORE CACHE] " << path << " was built for another configuration, resetting it." << std::endl;
+            }
+            std::memset(static_cast<void*>(entries_), 0, slots * sizeof(Entry));
+            *header_ = {CACHE_MAGIC, CACHE_VERSION, 0, scoring_signature(), slots, 0};
+        }
+    }
+
+    ScoreCache::~ScoreCache() {
+        if (fd_ >= 0) {
+            ::munmap(header_, mapped_bytes_);
+            ::close(fd_);
+        }
+    }
+
+    size_t ScoreCache::size() const {
+        return header_->count;
+    }
+
+    bool ScoreCache::lookup(const PairKey& key, int32_t& score) {
+        stats_.lookups++;
+        for (size_t i = key.lo & mask_;; i = (i + 1) & mask_) {
+            const Entry& e = entries_[i];
+            if (!e.used) return false;
+            if (e.lo == key.lo && e.hi == key.hi) {
+                score = e.score;
+                stats_.hits++;
+                return true;
+            }
+        }
+    }
+
+    void ScoreCache::insert(const PairKey& key, int32_t score) {
+        stats_.inserts++;
+        size_t home = key.lo & mask_;
+
+        if (header_->count >= capacity() / 4 * 3) {
+            // Full enough that probe chains get long: overwrite the home slot.
+            // Keys further down its chain stay reachable since the slot stays used.
+            entries_[home] = {key.lo, key.hi, score, 1};
+            return;
+        }
+
+        for (size_t i = home;; i = (i + 1) & mask_) {
+            Entry& e = entries_[i];
+            if (!e.used) {
+                e = {key.lo, key.hi, score, 1};
+                header_->count++;
+                return;
+            }
+            if (e.lo == key.lo && e.hi == key.hi) {
+                e.score = score;
+                return;
+            }
+        }
+    }
+
+    class CachedBackend : public Backend {
+    public:
+        CachedBackend(std::unique_ptr<Backend> inner, size_t capacity, const std::string& path)
+            : inner_(std::move(inner)), cache_(capacity, path) {}
+
+        ~CachedBackend() override {
+            const ScoreCache::Stats& s = cache_.stats();
+            std::cout << "[SCORE CACHE] " << s.hits << "/" << s.lookups << " cache hits, "
+                << deduped_ << " in-batch duplicates, " << cache_.size() << " entries stored." << std::endl;
+        }
+
+        std::string name() const override { return "cached(" + inner_->name() + ")"; }
+
+        size_t preferred_batch() const override { return inner_->preferred_batch(); }
+
+        Scores align(const Batch& batch) override {
+            Scores scores(batch.size());
+            std::vector<PairKey> keys(batch.size());
+            // Pair index -> index in the unique batch, or -1 if it was a hit
+            std::vector<int64_t> slot(batch.size(), -1);
+            std::unordered_map<uint64_t, std::vector<size_t>> seen;
+            // Unique batch index -> pair index
+            std::vector<size_t> unique_pair;
+            Batch unique;
+
+            for (size_t i = 0; i < batch.size(); i++) {
+                keys[i] = pair_key(batch.target[i], batch.database[i]);
+                if (cache_.lookup(keys[i], scores[i])) continue;
+
+                std::vector<size_t>& candidates = seen[keys[i].lo];
+                for (size_t u : candidates) {
+                    if (keys[unique_pair[u]] == keys[i]) {
+                        slot[i] = u;
+                        deduped_++;
+                        break;
+                    }
+                }
+                if (slot[i] >= 0) continue;
+
+                slot[i] = unique.size();
+                candidates.push_back(unique.size());
+                unique_pair.push_back(i);
+                unique.target.push_back(batch.target[i], batch.target.id(i));
+                unique.database.push_back(batch.database[i], batch.database.id(i));
+            }
+
+            Scores computed;
+            if (unique.size() > 0) computed = inner_->align(unique);
+
+            for (size_t u = 0; u < unique.size(); u++) {
+                cache_.insert(keys[unique_pair[u]], computed[u]);
+            }
+            for (size_t i = 0; i < batch.size(); i++) {
+                if (slot[i] >= 0) scores[i] = computed[slot[i]];
+            }
+            return scores;
+        }
+
+    private:
+        std::unique_ptr<Backend> inner_;
+        ScoreCache cache_;
+        uint64_t deduped_ = 0;
+    };
+
+    std::unique_ptr<Backend> make_cached_backend(std::unique_ptr<Backend> inner, size_t capacity, const std::string& path) {
+        return std::make_unique<CachedBackend>(std::move(inner), capacity, path);
+    }
+
+} // namespace swaie
@@ -0,0 +1,478 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/seqreader.h"
+#include "../common/fastareader.h"
+#include "../common/trace.h"
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <stdexcept>
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+
+namespace swaie {
+
+    const size_t READ_CHUNK = 1 << 20;
+    const size_t RECORDS_PER_BATCH = 1024;
+    const size_t GZIP_HEADER = 12;
+
+    template <typename T>
+    class SequenceReader::Queue {
+    public:
+        explicit Queue(size_t depth) : depth_(depth) {}
+
+        // false once the queue is closed; the item is dropped
+        bool push(T item) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_full_.wait(lock, [&] { return closed_ || items_.size() < depth_; });
+            if (closed_) return false;
+            items_.push_back(std::move(item));
+            not_empty_.notify_one();
+            return true;
+        }
+
+        // false once the queue is closed and drained
+        bool pop(T& item) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            not_empty_.wait(lock, [&] { return closed_ || !items_.empty(); });
+            if (items_.empty()) return false;
+            item = std::move(items_.front());
+            items_.pop_front();
+            not_full_.notify_one();
+            return true;
+        }
+
+        void close() {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+            not_full_.notify_all();
+            not_empty_.notify_all();
+        }
+
+    private:
+        size_t depth_;
+        bool closed_ = false;
+        std::deque<T> items_;
+        std::mutex mutex_;
+        std::condition_variable not_full_;
+        std::condition_variable not_empty_;
+    };
+
+    static std::future<std::string> ready(std::string data) {
+        std::promise<std::string> promise;
+        promise.set_value(std::move(data));
+        return promise.get_future();
+    }
+
+    SequenceReader::SequenceReader(const std::string& path, ReaderOptions options) : options_(options) {
+        if (path == "-") {
+            fd_ = STDIN_FILENO;
+        } else {
+            fd_ = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd_ < 0) {
+                throw std::runtime_error("[SEQ READER] Cannot open " + path + ": " + std::strerror(errno));
+            }
+        }
+        posix_fadvise(fd_, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+        // Sniff the compression from the first bytes; they stay in pending_
+        char head[GZIP_HEADER + 4];
+        size_t got = read_raw(head, sizeof(head));
+        pending_.assign(head, got);
+
+        const unsigned char* h = reinterpret_cast<const unsigned char*>(head);
+        bool gzip = got >= GZIP_HEADER && h[0] == 0x1f && h[1] == 0x8b && h[2] == 8;
+        bool bgzf = gzip && (h[3] & 4) && got >= GZIP_HEADER + 4 && h[12] == 'B' && h[13] == 'C';
+        compression_ = bgzf ? "BGZF" : gzip ? "gzip" : "plain";
+
+        chunks_ = std::make_unique<Queue<std::future<std::string>>>(options_.queue_depth);
+        records_ = std::make_unique<Queue<Records>>(options_.queue_depth);
+
+        decoder_ = std::thread([this, gzip, bgzf] {
+            trace::set_thread_name("seq decoder");
+            try {
+                if (bgzf) decode_bgzf();
+                else if (gzip) decode_gzip();
+                else decode_plain();
+            } catch (...) {
+                fail(std::current_exception());
+            }
+            chunks_->close();
+        });
+        parser_ = std::thread([this] {
+            trace::set_thread_name("seq parser");
+            try {
+                parse();
+            } catch (...) {
+                fail(std::current_exception());
+            }
+            records_->close();
+        });
+    }
+
+    SequenceReader::~SequenceReader() {
+        records_->close();
+        chunks_->close();
+        parser_.join();
+        decoder_.join();
+        if (fd_ != STDIN_FILENO) ::close(fd_);
+    }
+
+    std::string SequenceReader::format() const {
+        char marker = record_marker_.load();
+        std::string type = (marker == '>') ? "FASTA" : (marker == '@') ? "FASTQ" : "unknown";
+        return type + " (" + compression_ + ")";
+    }
+
+    void SequenceReader::fail(std::exception_ptr error) {
+        {
+            std::lock_guard<std::mutex> lock(error_mutex_);
+            if (!error_) error_ = error;
+        }
+        records_->close();
+        chunks_->close();
+    }
+
+    // Reads until bytes are in or the input ends, sniffed bytes first
+    size_t SequenceReader::read_raw(char* dst, size_t bytes) {
+        size_t done = std::min(bytes, pending_.size());
+        std::memcpy(dst, pending_.data(), done);
+        pending_.erase(0, done);
+
+        while (done < bytes) {
+            ssize_t n = ::read(fd_, dst + done, bytes - done);
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0) throw std::runtime_error(std::string("[SEQ READER] Read failed: ") + std::strerror(errno));
+            if (n == 0) break;
+            done += n;
+        }
+        return done;
+    }
+
+    void SequenceReader::decode_plain() {
+        for (;;) {
+            std::string chunk(READ_CHUNK, '\0');
+            chunk.resize(read_raw(&chunk[0], chunk.size()));
+            if (chunk.empty() || !chunks_->push(ready(std::move(chunk)))) return;
+        }
+    }
+
+    // Single-threaded inflate for ordinary gzip, concatenated members included
+    void SequenceReader::decode_gzip() {
+        z_stream zs;
+        std::memset(&zs, 0, sizeof(zs));
+        if (inflateInit2(&zs, 15 + 32) != Z_OK) throw std::runtime_error("[SEQ READER] inflateInit failed");
+        std::unique_ptr<z_stream, int(*)(z_stream*)> guard(&zs, inflateEnd);
+
+        std::vector<char> in(READ_CHUNK);
+        bool eof = false;
+        for (;;) {
+            if (zs.avail_in == 0 && !eof) {
+                size_t n = read_raw(in.data(), in.size());
+                eof = n < in.size();
+                zs.next_in = reinterpret_cast<Bytef*>(in.data());
+                zs.avail_in = n;
+            }
+
+            trace::Span span("inflate");
+            std::string out(READ_CHUNK, '\0');
+            zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+            zs.avail_out = out.size();
+            int ret = inflate(&zs, Z_NO_FLUSH);
+            out.resize(out.size() - zs.avail_out);
+            if (!out.empty() && !chunks_->push(ready(std::move(out)))) return;
+
+            if (ret == Z_STREAM_END) {
+                // Another member may follow; the input can end right at a read boundary
+                if (zs.avail_in == 0 && !eof) {
+                    size_t n = read_raw(in.data(), in.size());
+                    eof = n < in.size();
+                    zs.next_in = reinterpret_cast<Bytef*>(in.data());
+                    zs.avail_in = n;
+                }
+                if (zs.avail_in == 0) return;
+                inflateReset(&zs);
+            } else if (ret == Z_BUF_ERROR && zs.avail_in == 0 && eof) {
+                throw std::runtime_error("[SEQ READER] Truncated gzip stream");
+            } else if (ret != Z_OK && ret != Z_BUF_ERROR) {
+                throw std::runtime_error(std::string("[SEQ READER] Corrupt gzip stream: ") + (zs.msg ? zs.msg : "inflate failed"));
+            }
+        }
+    }
+
+    // BGZF is a series of independent gzip members whose header records the
+    // member size, so blocks can be split off without inflating them. Each
+    // block is handed to a worker together with a promise whose future was
+    // queued in file order: the parser consumes the futures in that order,
+    // and the bounded chunk queue caps the blocks in flight.
+    void SequenceReader::decode_bgzf() {
+        struct Job {
+            std::string block;
+            std::promise<std::string> out;
+        };
+        Queue<Job> jobs(options_.queue_depth);
+
+        unsigned threads = options_.threads ? options_.threads : std::max(1u, std::thread::hardware_concurrency());
+        std::vector<std::thread> workers;
+        for (unsigned t = 0; t < threads; t++) {
+            workers.emplace_back([&jobs] {
+                trace::set_thread_name("bgzf worker");
+                Job job;
+                while (jobs.pop(job)) {
+                    trace::Span span("inflate");
+                    try {
+                        const std::string& b = job.block;
+                        size_t xlen = (unsigned char)b[10] | ((unsigned char)b[11] << 8);
+                        size_t data = GZIP_HEADER + xlen;
+                        const unsigned char* trailer = reinterpret_cast<const unsigned char*>(b.data() + b.size() - 8);
+                        uint32_t crc = trailer[0] | (trailer[1] << 8) | (trailer[2] << 16) | ((uint32_t)trailer[3] << 24);
+                        uint32_t isize = trailer[4] | (trailer[5] << 8) | (trailer[6] << 16) | ((uint32_t)trailer[7] << 24);
+
+                        std::string out(isize, '\0');
+                        z_stream zs;
+                        std::memset(&zs, 0, sizeof(zs));
+                        if (inflateInit2(&zs, -15) != Z_OK) throw std::runtime_error("[SEQ READER] inflateInit failed");
+                        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(b.data() + data));
+                        zs.avail_in = b.size() - data - 8;
+                        zs.next_out = reinterpret_cast<Bytef*>(&out[0]);
+                        zs.avail_out = isize;
+                        int ret = inflate(&zs, Z_FINISH);
+                        inflateEnd(&zs);
+
+                        if (ret != Z_STREAM_END || zs.avail_out != 0 ||
+                            crc32(0, reinterpret_cast<const Bytef*>(out.data()), isize) != crc) {
+                            throw std::runtime_error("[SEQ READER] Corrupt BGZF block");
+                        }
+                        job.out.set_value(std::move(out));
+                    } catch (...) {
+                        job.out.set_exception(std::current_exception());
+                    }
+                }
+            });
+        }
+
+        try {
+            for (;;) {
+                char header[GZIP_HEADER];
+                size_t got = read_raw(header, GZIP_HEADER);
+                if (got == 0) break;
+
+                const unsigned char* h = reinterpret_cast<const unsigned char*>(header);
+                if (got < GZIP_HEADER || h[0] != 0x1f || h[1] != 0x8b || !(h[3] & 4)) {
+                    throw std::runtime_error("[SEQ READER] Truncated or non-BGZF block in BGZF input");
+                }
+                size_t xlen = h[10] | (h[11] << 8);
+                std::string extra(xlen, '\0');
+                if (read_raw(&extra[0], xlen) != xlen) throw std::runtime_error("[SEQ READER] Truncated BGZF header");
+
+                // Find the BC subfield holding the block size minus one
+                size_t block_size = 0;
+                for (size_t i = 0; i + 4 <= xlen;) {
+                    size_t slen = (unsigned char)extra[i + 2] | ((unsigned char)extra[i + 3] << 8);
+                    if (extra[i] == 'B' && extra[i + 1] == 'C' && slen == 2 && i + 6 <= xlen) {
+                        block_size = ((unsigned char)extra[i + 4] | ((unsigned char)extra[i + 5] << 8)) + 1;
+                    }
+                    i += 4 + slen;
+                }
+                if (block_size < GZIP_HEADER + xlen + 8) throw std::runtime_error("[SEQ READER] BGZF block without a size");
+
+                Job job;
+                job.block.reserve(block_size);
+                job.block.append(header, GZIP_HEADER).append(extra);
+                job.block.resize(block_size);
+                size_t rest = block_size - GZIP_HEADER - xlen;
+                if (read_raw(&job.block[GZIP_HEADER + xlen], rest) != rest) throw std::runtime_error("[SEQ READER] Truncated BGZF block");
+
+                if (!chunks_->push(job.out.get_future())) break;
+                if (!jobs.push(std::move(job))) break;
+            }
+        } catch (...) {
+            jobs.close();
+            for (std::thread& w : workers) w.join();
+            throw;
+        }
+        jobs.close();
+        for (std::thread& w : workers) w.join();
+    }
+
+    void SequenceReader::parse() {
+        uint8_t encode[256];
+        for (int c = 0; c < 256; c++) encode[c] = (uint8_t)(unsigned)fastareader::compression(std::toupper(c));
+
+        enum { HEADER, SEQUENCE, QUALITY } state = HEADER;
+        // Reused for every record; emit() copies it into the batch arena
+        std::vector<uint8_t> seq;
+        uint64_t record = 0;
+        std::string name;
+        size_t seq_len = 0;
+        size_t qual_len = 0;
+        bool in_record = false;
+        Records batch;
+        bool stopped = false;
+
+        auto emit = [&]() {
+            if (options_.fixed_length && options_.max_len) {
+                // Records alternate target, database, as read_pairs() takes them
+                uint8_t pad = record % 2 == 0 ? TARGET_PAD : DATABASE_PAD;
+                seq.resize(options_.max_len, pad);
+                seq.push_back(pad);
+                seq.push_back(pad);
+            }
+            if (batch.seqs.empty()) batch.seqs.reserve(RECORDS_PER_BATCH, RECORDS_PER_BATCH * seq.size());
+            batch.seqs.push_back(SequenceView(seq.data(), seq.size()), record++);
+            batch.info.push_back({std::move(name), seq_len});
+            seq.clear();
+            name.clear();
+            in_record = false;
+            if (batch.seqs.size() == RECORDS_PER_BATCH) {
+                stopped = !records_->push(std::move(batch));
+                batch = Records();
+            }
+        };
+
+        auto line = [&](const char* s, size_t n) {
+            if (n > 0 && s[n - 1] == '\r') n--;
+            if (n == 0) return;
+
+            char marker = record_marker_.load();
+            if (marker == 0) {
+                if (s[0] != '>' && s[0] != '@') throw std::runtime_error("[SEQ READER] Input is neither FASTA nor FASTQ");
+                record_marker_ = marker = s[0];
+            }
+
+            if (marker == '@' && state == QUALITY) {
+                qual_len += n;
+                if (qual_len >= seq_len) {
+                    emit();
+                    state = HEADER;
+                }
+                return;
+            }
+            if (s[0] == marker && (marker == '>' || state == HEADER)) {
+                if (in_record) emit();
+                in_record = true;
+                seq_len = 0;
+                if (options_.keep_names) {
+                    size_t end = 1;
+                    while (end < n && !std::isspace((unsigned char)s[end])) end++;
+                    name.assign(s + 1, end - 1);
+                }
+                state = SEQUENCE;
+                return;
+            }
+            if (marker == '@' && state == HEADER) throw std::runtime_error("[SEQ READER] Malformed FASTQ record");
+            if (marker == '@' && s[0] == '+') {
+                qual_len = 0;
+                state = QUALITY;
+                if (seq_len == 0) {
+                    emit();
+                    state = HEADER;
+                }
+                return;
+            }
+            if (!in_record) return;
+
+            size_t take = n;
+            if (options_.max_len) take = std::min(n, options_.max_len - std::min(options_.max_len, seq.size()));
+            for (size_t i = 0; i < take; i++) seq.push_back(encode[(unsigned char)s[i]]);
+            seq_len += n;
+        };
+
+        std::string carry;
+        std::future<std::string> next;
+        while (!stopped && chunks_->pop(next)) {
+            std::string chunk = next.get();
+            trace::Span span("parse");
+            size_t start = 0;
+            for (;;) {
+                const char* nl = static_cast<const char*>(std::memchr(chunk.data() + start, '\n', chunk.size() - start));
+                if (!nl) break;
+                size_t end = nl - chunk.data();
+                if (carry.empty()) {
+                    line(chunk.data() + start, end - start);
+                } else {
+                    carry.append(chunk, start, end - start);
+                    line(carry.data(), carry.size());
+                    carry.clear();
+                }
+                start = end + 1;
+            }
+            carry.append(chunk, start, std::string::npos);
+        }
+        if (stopped) return;
+
+        line(carry.data(), carry.size());
+        if (state == QUALITY || (record_marker_ == '@' && in_record)) {
+            throw std::runtime_error("[SEQ READER] Truncated FASTQ record");
+        }
+        if (in_record) emit();
+        if (!batch.seqs.empty()) records_->push(std::move(batch));
+    }
+
+    bool SequenceReader::next_view(SequenceView& seq, uint64_t& id, RecordInfo* info) {
+        while (current_pos_ == current_.seqs.size()) {
+            previous_ = std::move(current_);
+            current_ = Records();
+            current_pos_ = 0;
+            if (!records_->pop(current_)) {
+                std::lock_guard<std::mutex> lock(error_mutex_);
+                if (error_) std::rethrow_exception(error_);
+                return false;
+            }
+        }
+        if (info) *info = std::move(current_.info[current_pos_]);
+        id = current_.seqs.id(current_pos_);
+        seq = current_.seqs[current_pos_++];
+        return true;
+    }
+
+    bool SequenceReader::next(std::vector<alphabet_datatype>& seq, RecordInfo* info) {
+        SequenceView view;
+        uint64_t id;
+        if (!next_view(view, id, info)) return false;
+        seq.assign(view.begin(), view.end());
+        return true;
+    }
+
+    size_t SequenceReader::read_pairs(Batch& batch, size_t max_pairs, std::vector<RecordInfo>* info) {
+        size_t added = 0;
+        SequenceView target, database;
+        uint64_t target_id, database_id;
+        RecordInfo target_info, database_info;
+        while (added < max_pairs && next_view(target, target_id, &target_info) && next_view(database, database_id, &database_info)) {
+            batch.target.push_back(target, target_id);
+            batch.database.push_back(database, database_id);
+            if (info) {
+                info->push_back(std::move(target_info));
+                info->push_back(std::move(database_info));
+            }
+            added++;
+        }
+        return added;
+    }
+
+} // namespace swaie
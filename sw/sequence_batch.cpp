@@ -0,0 +1,132 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/sequence_batch.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace swaie {
+
+    size_t SequenceBatch::bases() const {
+        if (count_ == 0) return 0;
+        const Storage& s = *storage_;
+        size_t last = first_ + count_ - 1;
+        return s.offset[last] + s.length[last] - s.offset[first_];
+    }
+
+    SequenceBatch::Storage& SequenceBatch::own() {
+        if (storage_.use_count() == 1 && first_ + count_ == storage_->offset.size()) return *storage_;
+
+        auto fresh = std::make_shared<Storage>();
+        const Storage& s = *storage_;
+        size_t begin = count_ ? s.offset[first_] : 0;
+        fresh->bases.assign(s.bases.begin() + begin, s.bases.begin() + begin + bases());
+        fresh->offset.reserve(count_);
+        for (size_t i = first_; i < first_ + count_; i++) fresh->offset.push_back(s.offset[i] - begin);
+        fresh->length.assign(s.length.begin() + first_, s.length.begin() + first_ + count_);
+        fresh->id.assign(s.id.begin() + first_, s.id.begin() + first_ + count_);
+
+        storage_ = std::move(fresh);
+        first_ = 0;
+        return *storage_;
+    }
+
+    void SequenceBatch::reserve(size_t sequences, size_t bases) {
+        Storage& s = own();
+        s.bases.reserve(s.bases.size() + bases);
+        s.offset.reserve(s.offset.size() + sequences);
+        s.length.reserve(s.length.size() + sequences);
+        s.id.reserve(s.id.size() + sequences);
+    }
+
+    uint8_t* SequenceBatch::append(size_t length, uint64_t id) {
+        if (length > UINT32_MAX) throw std::runtime_error("[SEQUENCE BATCH] Sequence of " + std::to_string(length) + " bases is too long");
+        Storage& s = own();
+        size_t offset = s.bases.size();
+        s.bases.resize(offset + length);
+        s.offset.push_back(offset);
+        s.length.push_back((uint32_t)length);
+        s.id.push_back(id);
+        count_++;
+        return s.bases.data() + offset;
+    }
+
+    void SequenceBatch::push_back(SequenceView seq, uint64_t id) {
+        // seq may point into our own arena, which append() can move
+        if (seq.data() >= storage_->bases.data() && seq.data() < storage_->bases.data() + storage_->bases.size()) {
+            std::vector<uint8_t> copy(seq.begin(), seq.end());
+            std::memcpy(append(copy.size(), id), copy.data(), copy.size());
+            return;
+        }
+        uint8_t* dst = append(seq.size(), id);
+        if (seq.size()) std::memcpy(dst, seq.data(), seq.size());
+    }
+
+    void SequenceBatch::push_back(SequenceView seq) {
+        push_back(seq, count_);
+    }
+
+    void SequenceBatch::push_back(const std::vector<alphabet_datatype>& seq) {
+        uint8_t* dst = append(seq.size(), count_);
+        for (size_t i = 0; i < seq.size(); i++) dst[i] = (uint8_t)(unsigned)seq[i];
+    }
+
+    void SequenceBatch::append(const SequenceBatch& other) {
+        if (other.empty()) return;
+        if (empty() && first_ == 0) {
+            *this = other;
+            return;
+        }
+        // other may share our storage; take what we need before own() moves it
+        std::shared_ptr<Storage> keep = other.storage_;
+        Storage& s = own();
+        const Storage& o = *keep;
+        size_t begin = o.offset[other.first_];
+        size_t base = s.bases.size();
+        s.bases.insert(s.bases.end(), o.bases.begin() + begin, o.bases.begin() + begin + other.bases());
+        for (size_t i = other.first_; i < other.first_ + other.count_; i++) {
+            s.offset.push_back(o.offset[i] - begin + base);
+            s.length.push_back(o.length[i]);
+            s.id.push_back(o.id[i]);
+        }
+        count_ += other.count_;
+    }
+
+    void SequenceBatch::clear() {
+        storage_ = std::make_shared<Storage>();
+        first_ = 0;
+        count_ = 0;
+    }
+
+    SequenceBatch SequenceBatch::slice(size_t first, size_t count) const {
+        if (first > count_ || count > count_ - first) throw std::out_of_range("[SEQUENCE BATCH] Slice past the end of the batch");
+        SequenceBatch part;
+        part.storage_ = storage_;
+        part.first_ = first_ + first;
+        part.count_ = count;
+        return part;
+    }
+
+} // namespace swaie
@@ -0,0 +1,179 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/server.h"
+#include "../common/protocol.h"
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+namespace swaie {
+
+    Server::Server(Aligner& aligner, const std::string& socket_path, Aligner* express, size_t express_pairs)
+        : aligner_(aligner), express_(express), express_pairs_(express_pairs), socket_path_(socket_path) {
+
+        sockaddr_un addr = {};
+        addr.sun_family = AF_UNIX;
+        if (socket_path.size() >= sizeof(addr.sun_path)) {
+            throw std::runtime_error("[SWAIED] Socket path too long: " + socket_path);
+        }
+        std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+
+        listen_fd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listen_fd_ < 0) throw std::runtime_error("[SWAIED] socket(): " + std::string(std::strerror(errno)));
+
+        ::unlink(socket_path.c_str());
+        if (::bind(listen_fd_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) < 0 || ::listen(listen_fd_, 64) < 0) {
+            std::string reason = std::strerror(errno);
+            ::close(listen_fd_);
+            throw std::runtime_error("[SWAIED] Cannot listen on " + socket_path + ": " + reason);
+        }
+    }
+
+    Server::~Server() {
+        stop();
+        for (std::thread& t : clients_) t.join();
+        ::close(listen_fd_);
+        ::unlink(socket_path_.c_str());
+    }
+
+    void Server::stop() {
+        if (stopping_.exchange(true)) return;
+        ::shutdown(listen_fd_, SHUT_RDWR);
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (int fd : client_fds_) ::shutdown(fd, SHUT_RDWR);
+    }
+
+    void Server::serve() {
+        while (!stopping_) {
+            int fd = ::accept4(listen_fd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (fd < 0) {
+                if (errno == EINTR) continue;
+                if (stopping_) break;
+                std::cerr << "[SWAIED] accept(): " << std::strerror(errno) << std::endl;
+                continue;
+            }
+
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) {
+                ::close(fd);
+                break;
+            }
+            // Reap clients that hung up so a long-lived daemon does not pile up threads
+            for (std::thread::id id : finished_) {
+                for (size_t i = 0; i < clients_.size(); i++) {
+                    if (clients_[i].get_id() == id) {
+                        clients_[i].join();
+                        clients_.erase(clients_.begin() + i);
+                        break;
+                    }
+                }
+            }
+            finished_.clear();
+
+            client_fds_.push_back(fd);
+            clients_.emplace_back(&Server::handle, this, fd);
+        }
+    }
+
+    // The reader loop submits requests as they arrive; a writer thread sends
+    // the responses back in request order as their futures complete.
+    void Server::handle(int fd) {
+        struct Pending {
+            uint64_t request_id;
+            std::future<Scores> scores;
+            std::string error;
+        };
+        std::deque<Pending> pending;
+        std::mutex pending_mutex;
+        std::condition_variable pending_cv;
+        bool reader_done = false;
+
+        std::thread writer([&] {
+            bool connected = true;
+            for (;;) {
+                Pending next;
+                {
+                    std::unique_lock<std::mutex> lock(pending_mutex);
+                    pending_cv.wait(lock, [&] { return !pending.empty() || reader_done; });
+                    if (pending.empty()) return;
+                    next = std::move(pending.front());
+                    pending.pop_front();
+                }
+
+                if (!next.error.empty()) {
+                    connected = connected && send_error(fd, next.request_id, STATUS_BAD_REQUEST, next.error);
+                    continue;
+                }
+                try {
+                    Scores scores = next.scores.get();
+                    connected = connected && send_response(fd, next.request_id, scores);
+                } catch (const std::exception& e) {
+                    connected = connected && send_error(fd, next.request_id, STATUS_BACKEND_ERROR, e.what());
+                }
+            }
+        });
+
+        for (;;) {
+            RequestHeader header;
+            Batch batch;
+            std::string error;
+            if (!recv_request(fd, header, batch, error)) break;
+
+            Pending entry{header.request_id, {}, error};
+            if (error.empty()) {
+                Aligner& aligner = express_ && batch.size() <= express_pairs_ ? *express_ : aligner_;
+                entry.scores = aligner.submit(std::move(batch));
+            }
+
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            pending.push_back(std::move(entry));
+            pending_cv.notify_one();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex);
+            reader_done = true;
+        }
+        pending_cv.notify_one();
+        writer.join();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (size_t i = 0; i < client_fds_.size(); i++) {
+            if (client_fds_[i] == fd) {
+                client_fds_.erase(client_fds_.begin() + i);
+                break;
+            }
+        }
+        finished_.push_back(std::this_thread::get_id());
+        ::close(fd);
+    }
+
+} // namespace swaie
@@ -0,0 +1,285 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/sharded.h"
+#include "../common/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace swaie {
+
+    // Weight of the newest chunk in a shard's throughput average
+    static const double RATE_SMOOTHING = 0.3;
+
+    typedef std::chrono::steady_clock Clock;
+
+    class ShardedBackend : public Backend {
+    public:
+        ShardedBackend(std::vector<std::unique_ptr<Backend>> backends, size_t chunk_pairs) {
+            if (backends.empty()) throw std::runtime_error("[SHARDED] No backend to shard over");
+
+            size_t largest = 0;
+            for (auto& backend : backends) {
+                largest = std::max(largest, backend->preferred_batch());
+                shards_.emplace_back();
+                shards_.back().backend = std::move(backend);
+            }
+            chunk_ = chunk_pairs ? chunk_pairs : (largest ? largest : 1024);
+
+            for (size_t i = 0; i < shards_.size(); i++) {
+                shards_[i].thread = std::thread(&ShardedBackend::worker, this, i);
+            }
+        }
+
+        ~ShardedBackend() override {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                stopping_ = true;
+            }
+            work_.notify_all();
+            for (Shard& shard : shards_) shard.thread.join();
+
+            uint64_t total = 0;
+            for (const Shard& shard : shards_) total += shard.pairs;
+            for (const Shard& shard : shards_) {
+                std::cout << "[SHARDED] " << shard.backend->name() << ": " << shard.pairs << " pairs ("
+                    << (total ? 100.0 * shard.pairs / total : 0.0) << "%), "
+                    << (uint64_t)shard.rate << " pairs/s." << std::endl;
+            }
+        }
+
+        std::string name() const override {
+            std::string names;
+            for (const Shard& shard : shards_) names += (names.empty() ? "" : ",") + shard.backend->name();
+            return "sharded(" + names + ")";
+        }
+
+        // Enough pairs for every shard to get a chunk
+        size_t preferred_batch() const override {
+            size_t total = 0;
+            for (const Shard& shard : shards_) total += std::max(chunk_, shard.backend->preferred_batch());
+            return total;
+        }
+
+        Scores align(const Batch& batch) override {
+            Scores scores(batch.size());
+            if (batch.size() == 0) return scores;
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            batch_ = &batch;
+            scores_ = scores.data();
+            next_ = 0;
+            error_ = nullptr;
+            busy_ = shards_.size();
+            generation_++;
+            work_.notify_all();
+
+            done_.wait(lock, [this] { return busy_ == 0; });
+            batch_ = nullptr;
+            scores_ = nullptr;
+            if (error_) std::rethrow_exception(error_);
+            return scores;
+        }
+
+    private:
+        struct Shard {
+            std::unique_ptr<Backend> backend;
+            std::thread thread;
+            double rate = 0;        // pairs/s, moving average; 0 until the first chunk
+            uint64_t pairs = 0;
+            // Still taking chunks of the current batch, and when the chunk
+            // it holds should be done at its rate
+            bool active = false;
+            Clock::time_point busy_until;
+        };
+
+        // Pairs a call on shard i takes the time of: whole preferred batches
+        size_t charged(size_t i, size_t pairs) const {
+            size_t unit = shards_[i].backend->preferred_batch();
+            return unit ? (pairs + unit - 1) / unit * unit : pairs;
+        }
+
+        // Pairs shard i takes next, called with the lock held. Far from the
+        // end that is a chunk scaled by the shard's rate. Near the end it is
+        // no more than the shard gets through before the other rated shards
+        // would be done with everything left, their chunks in flight
+        // included, so the last pairs go to whichever side frees up first;
+        // 0 when not even one preferred batch fits.
+        size_t grab(size_t i, Clock::time_point now) const {
+            const Shard& shard = shards_[i];
+            double fastest = 0;
+            for (const Shard& s : shards_) fastest = std::max(fastest, s.rate);
+
+            double weight = (shard.rate > 0 && fastest > 0) ? shard.rate / fastest : 1.0;
+            size_t remaining = batch_->size() - next_;
+            size_t unit = shard.backend->preferred_batch();
+            size_t pairs = std::min(charged(i, std::max<size_t>(1, (size_t)(chunk_ * weight))), remaining);
+            if (shard.rate <= 0) return pairs;
+
+            double others_rate = 0, backlog = 0;
+            for (size_t j = 0; j < shards_.size(); j++) {
+                const Shard& s = shards_[j];
+                if (j == i || !s.active || s.rate <= 0) continue;
+                others_rate += s.rate;
+                backlog += s.rate * std::max(0.0, std::chrono::duration<double>(s.busy_until - now).count());
+            }
+            if (others_rate == 0) return pairs;
+
+            double limit = (remaining + backlog) / others_rate * shard.rate;
+            if (charged(i, pairs) <= limit) return pairs;
+            return unit ? (size_t)(limit / unit) * unit : (size_t)limit;
+        }
+
+        void worker(size_t i) {
+            Shard& shard = shards_[i];
+            trace::set_thread_name("shard " + shard.backend->name());
+            uint64_t seen = 0;
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            for (;;) {
+                work_.wait(lock, [&] { return generation_ != seen || stopping_; });
+                if (stopping_) return;
+                seen = generation_;
+                shard.active = true;
+
+                while (!error_ && next_ < batch_->size()) {
+                    auto now = Clock::now();
+                    size_t count = grab(i, now);
+                    if (count == 0) break;
+                    size_t first = next_;
+                    next_ += count;
+                    shard.busy_until = shard.rate > 0 ? now + std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(charged(i, count) / shard.rate)) : now;
+                    const Batch& batch = *batch_;
+                    int32_t* scores = scores_;
+                    lock.unlock();
+
+                    Batch part = batch.slice(first, count);
+
+                    Scores result;
+                    std::exception_ptr error;
+                    auto start = Clock::now();
+                    try {
+                        result = shard.backend->align(part);
+                        if (result.size() != count) {
+                            throw std::runtime_error("[SHARDED] Backend " + shard.backend->name() + " returned a wrong number of scores");
+                        }
+                        std::copy(result.begin(), result.end(), scores + first);
+                    } catch (...) {
+                        error = std::current_exception();
+                    }
+                    double seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+                    lock.lock();
+                    shard.busy_until = Clock::now();
+                    if (error) {
+                        if (!error_) error_ = error;
+                        break;
+                    }
+                    double rate = charged(i, count) / std::max(seconds, 1e-9);
+                    shard.rate = shard.rate > 0 ? (1 - RATE_SMOOTHING) * shard.rate + RATE_SMOOTHING * rate : rate;
+                    shard.pairs += count;
+                }
+
+                shard.active = false;
+                if (--busy_ == 0) done_.notify_all();
+            }
+        }
+
+        std::vector<Shard> shards_;
+        size_t chunk_;
+
+        // The align() call being served
+        const Batch* batch_ = nullptr;
+        int32_t* scores_ = nullptr;
+        size_t next_ = 0;
+        size_t busy_ = 0;
+        uint64_t generation_ = 0;
+        std::exception_ptr error_;
+        bool stopping_ = false;
+
+        std::mutex mutex_;
+        std::condition_variable work_;
+        std::condition_variable done_;
+    };
+
+    std::unique_ptr<Backend> make_sharded_backend(std::vector<std::unique_ptr<Backend>> shards, size_t chunk_pairs) {
+        return std::make_unique<ShardedBackend>(std::move(shards), chunk_pairs);
+    }
+
+    std::unique_ptr<Backend> make_hybrid_backend(std::vector<std::unique_ptr<Backend>> devices, unsigned cpu_threads) {
+        if (devices.empty()) throw std::runtime_error("[SHARDED] No device to run next to the CPU");
+        if (cpu_threads == 0) {
+            unsigned cores = std::max(1u, std::thread::hardware_concurrency());
+            cpu_threads = cores > devices.size() ? cores - (unsigned)devices.size() : 1;
+        }
+        devices.push_back(make_cpu_simd8_backend(cpu_threads));
+        return make_sharded_backend(std::move(devices));
+    }
+
+    int32_t mock_score(SequenceView target, SequenceView database) {
+        size_t n = std::min<size_t>(SEQ_SIZE, std::min(target.size(), database.size()));
+        int32_t matches = 0;
+        for (size_t i = 0; i < n; i++) matches += (target[i] == database[i]);
+        return matches;
+    }
+
+    class MockBackend : public Backend {
+    public:
+        MockBackend(const std::string& name, double pairs_per_second, size_t preferred_batch)
+            : name_(name), rate_(pairs_per_second), preferred_(preferred_batch) {
+            if (rate_ <= 0) throw std::runtime_error("[SHARDED] Mock backend " + name + " needs a positive rate");
+        }
+
+        std::string name() const override { return name_; }
+
+        size_t preferred_batch() const override { return preferred_; }
+
+        Scores align(const Batch& batch) override {
+            // A card runs whole preferred batches, however few pairs they hold
+            size_t charged = preferred_ ? (batch.size() + preferred_ - 1) / preferred_ * preferred_ : batch.size();
+            auto deadline = std::chrono::steady_clock::now() + std::chrono::duration<double>(charged / rate_);
+            Scores scores(batch.size());
+            for (size_t i = 0; i < batch.size(); i++) scores[i] = mock_score(batch.target[i], batch.database[i]);
+            std::this_thread::sleep_until(deadline);
+            return scores;
+        }
+
+    private:
+        std::string name_;
+        double rate_;
+        size_t preferred_;
+    };
+
+    std::unique_ptr<Backend> make_mock_backend(const std::string& name, double pairs_per_second, size_t preferred_batch) {
+        return std::make_unique<MockBackend>(name, pairs_per_second, preferred_batch);
+    }
+
+} // namespace swaie
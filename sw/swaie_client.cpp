@@ -0,0 +1,124 @@
+/*
+MIT License
+
+Copyright (c) 2025 Carmine Pacilio
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <string>
+#include <chrono>
+#include <cstdlib>
+
+#include "../common/seqreader.h"
+#include "../common/client.h"
+#include "../common/prefilter.h"
+#include "../common/result_writer.h"
+
+#define DEFAULT_SOCKET "/tmp/swaied.sock"
+
+// Streams a FASTA/FASTQ file (plain, gzip or BGZF; "-" for stdin) to a
+// running swaied in fixed-size requests and optionally checks the returned
+// scores against the CPU reference.
+
+int main(int argc, char *argv[]) {
+
+	std::string socket_path = DEFAULT_SOCKET;
+	std::string filename = "SRR33920980.fasta";
+	size_t request_pairs = 500;
+	bool verify = false;
+	int min_score = 0;
+	std::string out_file;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--verify") verify = true;
+		else if (arg == "--socket" && i + 1 < argc) socket_path = argv[++i];
+		else if (arg == "--pairs" && i + 1 < argc) request_pairs = std::max(1, std::atoi(argv[++i]));
+		else if (arg == "--min-score" && i + 1 < argc) min_score = std::atoi(argv[++i]);
+		else if (arg == "--out" && i + 1 < argc) out_file = argv[++i];
+		else if (arg[0] != '-' || arg == "-") filename = arg;
+		else {
+			std::cerr << "Usage: " << argv[0] << " [--socket <path>] [--pairs <n>] [--verify [--min-score <score>]]"
+				<< " [--out <file.swres|file.tsv>] [input_file|-]" << std::endl;
+			return EXIT_FAILURE;
+		}
+	}
+
+	try {
+		// TSV results carry the record names
+		swaie::ReaderOptions options;
+		std::unique_ptr<swaie::ResultWriter> writer;
+		if (!out_file.empty()) {
+			swaie::ResultFormat format = swaie::result_format_for(out_file);
+			options.keep_names = format == swaie::ResultFormat::Tsv;
+			writer = std::make_unique<swaie::ResultWriter>(out_file, format);
+		}
+
+		swaie::SequenceReader reader(filename, options);
+		swaie::Client client(socket_path);
+		swaie::Scores scores;
+		swaie::Batch all;
+
+		// Requests go out as soon as they are read; the input is only kept for --verify
+		auto start = std::chrono::high_resolution_clock::now();
+		swaie::Batch request;
+		std::vector<swaie::RecordInfo> info;
+		while (reader.read_pairs(request, request_pairs, &info)) {
+			swaie::Scores part = client.align(request);
+			if (writer) writer->write(scores.size(), part, options.keep_names ? &info : nullptr);
+			scores.insert(scores.end(), part.begin(), part.end());
+
+			if (verify) {
+				all.append(request);
+			}
+			request = swaie::Batch();
+			info.clear();
+		}
+		if (writer) {
+			writer->close();
+			std::cout << "[SWAIE CLIENT] Wrote " << writer->stats().records << " scores to " << out_file << std::endl;
+		}
+		auto stop = std::chrono::high_resolution_clock::now();
+
+		auto duration = std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start);
+		std::cout << "[SWAIE CLIENT] " << scores.size() << " pairs in " << (float)duration.count() * 1e-6 << " ms" << std::endl;
+
+		if (verify) {
+			swaie::Scores golden = swaie::make_cpu_reference_backend()->align(all);
+			size_t mismatches = 0;
+			// With a daemon started with --min-score, filtered pairs only need to be below it
+			for (size_t i = 0; i < golden.size(); i++) {
+				if (scores[i] == swaie::FILTERED_SCORE) mismatches += (min_score == 0 || golden[i] >= min_score);
+				else mismatches += (scores[i] != golden[i]);
+			}
+			if (mismatches) {
+				std::cout << "\033[1;31m[SWAIE CLIENT] ✖ " << mismatches << " scores do not match reference.\033[0m" << std::endl;
+				return EXIT_FAILURE;
+			}
+			std::cout << "\033[1;32m[SWAIE CLIENT] ✔ All scores match reference.\033[0m" << std::endl;
+		}
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return 0;
+}
@@ -0,0 +1,210 @@
+/*
+MIT License
+
+Copyright (c) 2025 Carmine Pacilio
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <string>
+#include <sstream>
+#include <cstdlib>
+#include <csignal>
+#include <thread>
+#include <pthread.h>
+
+#include "../common/aligner.h"
+#include "../common/server.h"
+#include "../common/score_cache.h"
+#include "../common/trace.h"
+#include "../common/sharded.h"
+#include "../common/prefilter.h"
+
+#define DEFAULT_DEVICES "all"
+#define DEFAULT_SOCKET "/tmp/swaied.sock"
+
+// Long-running alignment service: the backend (and with it the xclbin,
+// kernels, buffers and runs) is created once, then batches from any number
+// of local clients are served over a Unix socket.
+
+static void usage(const char* argv0) {
+	std::cerr << "Usage: " << argv0 << " [--backend xrt|cpu-simd|cpu-simd8|cpu-trie|cpu-striped|cpu-reference|mock] [--xclbin <file>]" << std::endl;
+	std::cerr << "       [--device <id>[,<id>...]|all] [--mock-rate <pairs/s>[,<pairs/s>...]]" << std::endl;
+	std::cerr << "       [--socket <path>] [--linger-us <us>] [--threads <n>] [--hybrid]" << std::endl;
+	std::cerr << "       [--cache <file>] [--cache-entries <n>] [--no-cache] [--hugepages]" << std::endl;
+	std::cerr << "       [--trace <file.json>] [--min-score <score> [--kmer <k>]] [--express-pairs <n>]" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+
+	std::string backend_name = "xrt";
+	std::string xclbin_file;
+	std::string socket_path = DEFAULT_SOCKET;
+	std::string devices = DEFAULT_DEVICES;
+	std::string mock_rates = "100000";
+	unsigned threads = 0;
+	long linger_us = 200;
+	bool use_cache = true;
+	bool hybrid = false;
+	swaie::HostMemory host_memory = swaie::HostMemory::Mapped;
+	std::string cache_file;
+	size_t cache_entries = 1 << 22;
+	std::string trace_file;
+	int min_score = 0;
+	unsigned kmer = 4;
+	size_t express_pairs = 0;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--no-cache") { use_cache = false; continue; }
+		if (arg == "--hybrid") { hybrid = true; continue; }
+		if (arg == "--hugepages") { host_memory = swaie::HostMemory::HugePages; continue; }
+		if (i + 1 >= argc) { usage(argv[0]); return EXIT_FAILURE; }
+		if (arg == "--backend") backend_name = argv[++i];
+		else if (arg == "--xclbin") xclbin_file = argv[++i];
+		else if (arg == "--device") devices = argv[++i];
+		else if (arg == "--mock-rate") mock_rates = argv[++i];
+		else if (arg == "--socket") socket_path = argv[++i];
+		else if (arg == "--linger-us") linger_us = std::atol(argv[++i]);
+		else if (arg == "--threads") threads = std::atoi(argv[++i]);
+		else if (arg == "--cache") cache_file = argv[++i];
+		else if (arg == "--trace") trace_file = argv[++i];
+		else if (arg == "--min-score") min_score = std::atoi(argv[++i]);
+		else if (arg == "--kmer") kmer = std::atoi(argv[++i]);
+		else if (arg == "--cache-entries") cache_entries = std::strtoull(argv[++i], nullptr, 10);
+		else if (arg == "--express-pairs") express_pairs = std::strtoull(argv[++i], nullptr, 10);
+		else { usage(argv[0]); return EXIT_FAILURE; }
+	}
+
+	if (!trace_file.empty()) swaie::trace::enable();
+
+	// Route SIGINT/SIGTERM to a watcher thread; every other thread inherits the mask
+	sigset_t signals;
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGINT);
+	sigaddset(&signals, SIGTERM);
+	pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+	// --hybrid runs a CPU engine next to the cards (xrt or mock), --threads threads of it
+	if (hybrid && backend_name != "xrt" && backend_name != "mock") { usage(argv[0]); return EXIT_FAILURE; }
+	// --express-pairs keeps partition 0 of the first card for requests of up
+	// to that many pairs; it needs a partitioned xclbin and host build
+	if (express_pairs > 0 && (backend_name != "xrt" || NUM_PARTITIONS < 2)) {
+		std::cerr << "[SWAIED] --express-pairs needs the xrt backend built with PARTITIONS=2" << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	std::unique_ptr<swaie::Backend> backend;
+	std::unique_ptr<swaie::Backend> express;
+	try {
+		if (backend_name == "xrt") {
+			if (xclbin_file.empty()) { usage(argv[0]); return EXIT_FAILURE; }
+			std::cout << "[SWAIED] Loading xclbin file: " << xclbin_file << " on devices " << devices << std::endl;
+			if (hybrid || express_pairs > 0) {
+				std::vector<std::unique_ptr<swaie::Backend>> cards;
+				for (unsigned id : swaie::parse_device_list(devices)) {
+					if (express_pairs == 0) {
+						cards.push_back(swaie::make_xrt_backend(xclbin_file, id, host_memory));
+						continue;
+					}
+					// Every partition but the express one is a bulk shard of its own
+					for (auto& partition : swaie::make_xrt_partition_backends(xclbin_file, id, host_memory)) {
+						if (!express) express = std::move(partition);
+						else cards.push_back(std::move(partition));
+					}
+				}
+				if (hybrid) backend = swaie::make_hybrid_backend(std::move(cards), threads);
+				else backend = cards.size() == 1 ? std::move(cards[0]) : swaie::make_sharded_backend(std::move(cards));
+			} else {
+				backend = swaie::make_xrt_backend(xclbin_file, swaie::parse_device_list(devices), host_memory);
+			}
+		} else if (backend_name == "cpu-simd") {
+			backend = swaie::make_cpu_simd_backend(threads);
+		} else if (backend_name == "cpu-simd8") {
+			backend = swaie::make_cpu_simd8_backend(threads);
+		} else if (backend_name == "cpu-trie") {
+			backend = swaie::make_cpu_trie_backend(threads);
+		} else if (backend_name == "cpu-striped") {
+			// SEQ_SIZE bases like every other backend, as the cache keys and scores assume
+			backend = swaie::make_cpu_striped_backend(threads, SEQ_SIZE);
+		} else if (backend_name == "cpu-reference") {
+			backend = swaie::make_cpu_reference_backend();
+		} else if (backend_name == "mock") {
+			// One simulated card per rate, sharded like real ones; scores are not alignments
+			std::vector<std::unique_ptr<swaie::Backend>> cards;
+			std::stringstream rates(mock_rates);
+			std::string rate;
+			while (std::getline(rates, rate, ',')) {
+				cards.push_back(swaie::make_mock_backend("mock:" + std::to_string(cards.size()), std::atof(rate.c_str()), INPUT_SIZE));
+			}
+			if (hybrid) backend = swaie::make_hybrid_backend(std::move(cards), threads);
+			else backend = cards.size() == 1 ? std::move(cards[0]) : swaie::make_sharded_backend(std::move(cards));
+		} else {
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+		// Clients resubmitting the same reads hit the cache instead of the device
+		// Mock scores must not end up in a cache file shared with real backends
+		if (use_cache && backend_name != "mock") backend = swaie::make_cached_backend(std::move(backend), cache_entries, cache_file);
+		// Outside the cache, so a cache file never holds filtered scores
+		if (min_score > 0) backend = swaie::make_prefiltered_backend(std::move(backend), min_score, kmer, threads);
+		// No cache on the express lane: it is for jobs that want the device now
+		if (express && min_score > 0) express = swaie::make_prefiltered_backend(std::move(express), min_score, kmer, threads);
+	} catch (const std::exception &e) {
+		std::cerr << "[SWAIED] Error creating backend: " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	swaie::Aligner aligner(std::move(backend), 256, std::chrono::microseconds(linger_us));
+	// Small requests are sent as they come, without lingering for company
+	std::unique_ptr<swaie::Aligner> express_aligner;
+	if (express) express_aligner = std::make_unique<swaie::Aligner>(std::move(express), 256, std::chrono::microseconds(0));
+
+	try {
+		swaie::Server server(aligner, socket_path, express_aligner.get(), express_pairs);
+
+		std::thread watcher([&] {
+			int sig;
+			sigwait(&signals, &sig);
+			std::cout << "[SWAIED] Caught signal " << sig << ", shutting down." << std::endl;
+			server.stop();
+		});
+
+		std::cout << "[SWAIED] Serving " << aligner.backend().name() << " on " << socket_path << std::endl;
+		if (express_aligner) {
+			std::cout << "[SWAIED] Requests of up to " << express_pairs << " pairs go to " << express_aligner->backend().name() << std::endl;
+		}
+		server.serve();
+
+		// serve() only returns after stop(), i.e. after the watcher fired
+		watcher.join();
+	} catch (const std::exception &e) {
+		std::cerr << "[SWAIED] " << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	aligner.drain();
+	if (express_aligner) express_aligner->drain();
+	if (!trace_file.empty()) {
+		swaie::trace::print_summary(std::cout);
+		if (!swaie::trace::write_chrome_json(trace_file)) std::cerr << "[SWAIED] Cannot write trace " << trace_file << std::endl;
+	}
+	return 0;
+}
@@ -0,0 +1,294 @@
+/*
+MIT License
+
+Copyright (c) 2025 Carmine Pacilio
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <memory>
+#include <zlib.h>
+
+#include "../common/fastareader.h"
+#include "../common/packfile.h"
+
+// Synthetic workload generator: (target, database) pairs with a chosen
+// length distribution, identity, indel rate, N content and duplicate
+// fraction, written as FASTA, FASTQ (".gz" output names are gzipped) or a
+// pack file. The PRNG and distributions are implemented here, not taken
+// from <random>, so a seed gives the same dataset on every platform.
+
+// xoshiro256** seeded through splitmix64
+class Rng {
+public:
+	explicit Rng(uint64_t seed) {
+		for (uint64_t& s : s_) {
+			seed += 0x9e3779b97f4a7c15ULL;
+			uint64_t z = seed;
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+			s = z ^ (z >> 31);
+		}
+	}
+
+	uint64_t next() {
+		uint64_t result = rotl(s_[1] * 5, 7) * 9;
+		uint64_t t = s_[1] << 17;
+		s_[2] ^= s_[0];
+		s_[3] ^= s_[1];
+		s_[1] ^= s_[2];
+		s_[0] ^= s_[3];
+		s_[2] ^= t;
+		s_[3] = rotl(s_[3], 45);
+		return result;
+	}
+
+	// [0, 1)
+	double uniform() { return (next() >> 11) * 0x1.0p-53; }
+	// [0, n)
+	uint64_t below(uint64_t n) { return (uint64_t)(((__uint128_t)next() * n) >> 64); }
+	bool chance(double p) { return p > 0 && uniform() < p; }
+	double normal() {
+		double u1 = uniform(), u2 = uniform();
+		return std::sqrt(-2.0 * std::log(1.0 - u1)) * std::cos(2.0 * M_PI * u2);
+	}
+
+private:
+	static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+	uint64_t s_[4];
+};
+
+struct Config {
+	uint64_t pairs = INPUT_SIZE;
+	uint64_t seed = 1;
+	std::string length = "fixed:" + std::to_string(SEQ_SIZE);
+	double identity = 0.9;
+	double indel = 0.01;
+	double n_rate = 0.0;
+	double dup = 0.0;
+	std::string format = "fasta";
+	std::string out = "-";
+};
+
+// "fixed:L", "uniform:MIN-MAX" or "normal:MEAN,SD", lengths at least 1
+class LengthDist {
+public:
+	explicit LengthDist(const std::string& spec) {
+		size_t colon = spec.find(':');
+		kind_ = spec.substr(0, colon);
+		std::string args = colon == std::string::npos ? "" : spec.substr(colon + 1);
+		size_t sep = args.find_first_of("-,");
+		a_ = std::atof(args.substr(0, sep).c_str());
+		b_ = sep == std::string::npos ? a_ : std::atof(args.substr(sep + 1).c_str());
+		if ((kind_ != "fixed" && kind_ != "uniform" && kind_ != "normal") || a_ < 1 || (kind_ == "uniform" && b_ < a_)) {
+			throw std::runtime_error("[SWGEN] Bad length distribution: " + spec);
+		}
+	}
+
+	size_t draw(Rng& rng) const {
+		double len = a_;
+		if (kind_ == "uniform") len = a_ + rng.below((uint64_t)(b_ - a_) + 1);
+		else if (kind_ == "normal") len = std::round(a_ + b_ * rng.normal());
+		return (size_t)std::max(1.0, len);
+	}
+
+private:
+	std::string kind_;
+	double a_, b_;
+};
+
+static const char BASES[] = "ACGT";
+
+static std::string random_sequence(Rng& rng, size_t len) {
+	std::string s(len, 'A');
+	for (char& c : s) c = BASES[rng.below(4)];
+	return s;
+}
+
+// Substitutions at rate 1 - identity, insertions and deletions at indel / 2 each
+static std::string mutate(Rng& rng, const std::string& src, const Config& cfg) {
+	std::string out;
+	out.reserve(src.size() + src.size() / 8);
+	for (char base : src) {
+		if (rng.chance(cfg.indel / 2)) continue;
+		if (rng.chance(cfg.indel / 2)) out.push_back(BASES[rng.below(4)]);
+		if (rng.chance(1.0 - cfg.identity)) {
+			char sub = BASES[rng.below(3)];
+			out.push_back(sub == base ? 'T' : sub);
+		} else {
+			out.push_back(base);
+		}
+	}
+	return out;
+}
+
+static void add_ns(Rng& rng, std::string& seq, double rate) {
+	if (rate <= 0) return;
+	for (char& c : seq) if (rng.chance(rate)) c = 'N';
+}
+
+// Text output, plain or gzipped by the ".gz" suffix; "-" is stdout
+class TextSink {
+public:
+	explicit TextSink(const std::string& path) {
+		bool gz = path.size() > 3 && path.compare(path.size() - 3, 3, ".gz") == 0;
+		if (gz) {
+			gz_ = gzopen(path.c_str(), "wb6");
+			if (!gz_) throw std::runtime_error("[SWGEN] Cannot create " + path);
+			gzbuffer(gz_, 1 << 20);
+		} else {
+			file_ = path == "-" ? stdout : std::fopen(path.c_str(), "wb");
+			if (!file_) throw std::runtime_error("[SWGEN] Cannot create " + path);
+			std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+		}
+	}
+
+	~TextSink() {
+		if (gz_) gzclose(gz_);
+		if (file_ && file_ != stdout) std::fclose(file_);
+		else if (file_) std::fflush(file_);
+	}
+
+	void write(const std::string& s) {
+		bool ok = gz_ ? gzwrite(gz_, s.data(), s.size()) == (int)s.size() : std::fwrite(s.data(), 1, s.size(), file_) == s.size();
+		if (!ok) throw std::runtime_error("[SWGEN] Write failed");
+	}
+
+private:
+	gzFile gz_ = nullptr;
+	FILE* file_ = nullptr;
+};
+
+static void usage(const char* argv0) {
+	std::cerr << "Usage: " << argv0 << " [--pairs <n>] [--seed <s>] [--length fixed:L|uniform:MIN-MAX|normal:MEAN,SD]" << std::endl;
+	std::cerr << "       [--identity <0..1>] [--indel <rate>] [--n-rate <rate>] [--dup <fraction>]" << std::endl;
+	std::cerr << "       [--format fasta|fastq|pack] [--out <file|->]" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+
+	Config cfg;
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (i + 1 >= argc) { usage(argv[0]); return EXIT_FAILURE; }
+		std::string value = argv[++i];
+		if (arg == "--pairs") cfg.pairs = std::strtoull(value.c_str(), nullptr, 10);
+		else if (arg == "--seed") cfg.seed = std::strtoull(value.c_str(), nullptr, 10);
+		else if (arg == "--length") cfg.length = value;
+		else if (arg == "--identity") cfg.identity = std::atof(value.c_str());
+		else if (arg == "--indel") cfg.indel = std::atof(value.c_str());
+		else if (arg == "--n-rate") cfg.n_rate = std::atof(value.c_str());
+		else if (arg == "--dup") cfg.dup = std::atof(value.c_str());
+		else if (arg == "--format") cfg.format = value;
+		else if (arg == "--out") cfg.out = value;
+		else { usage(argv[0]); return EXIT_FAILURE; }
+	}
+	if (cfg.format != "fasta" && cfg.format != "fastq" && cfg.format != "pack") { usage(argv[0]); return EXIT_FAILURE; }
+	if (cfg.format == "pack" && cfg.out == "-") {
+		std::cerr << "[SWGEN] Pack files need a real --out path." << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	try {
+		LengthDist lengths(cfg.length);
+		Rng rng(cfg.seed);
+
+		std::unique_ptr<TextSink> text;
+		std::unique_ptr<swaie::PackWriter> pack;
+		if (cfg.format == "pack") pack = std::make_unique<swaie::PackWriter>(cfg.out);
+		else text = std::make_unique<TextSink>(cfg.out);
+
+		// Duplicates repeat one of the last DUP_WINDOW distinct pairs, so memory
+		// stays flat however many pairs are generated
+		const size_t DUP_WINDOW = 1 << 16;
+		std::vector<std::pair<std::string, std::string>> window;
+		uint64_t duplicates = 0;
+
+		swaie::Batch batch;
+		std::vector<swaie::RecordInfo> info;
+		std::string chunk;
+
+		for (uint64_t n = 0; n < cfg.pairs; n++) {
+			std::string target, database;
+			if (!window.empty() && rng.chance(cfg.dup)) {
+				const auto& pair = window[rng.below(window.size())];
+				target = pair.first;
+				database = pair.second;
+				duplicates++;
+			} else {
+				target = random_sequence(rng, lengths.draw(rng));
+				database = mutate(rng, target, cfg);
+				add_ns(rng, target, cfg.n_rate);
+				add_ns(rng, database, cfg.n_rate);
+				if (window.size() < DUP_WINDOW) window.emplace_back(target, database);
+				else window[n % DUP_WINDOW] = {target, database};
+			}
+
+			std::string name = "p" + std::to_string(n);
+			if (pack) {
+				// Same shape SequenceReader gives the short-read engines
+				for (const std::string* seq : {&target, &database}) {
+					bool is_target = seq == &target;
+					uint8_t* encoded = (is_target ? batch.target : batch.database).append(SEQ_SIZE + 2, is_target ? 2 * n : 2 * n + 1);
+					std::fill_n(encoded, SEQ_SIZE + 2, is_target ? TARGET_PAD : DATABASE_PAD);
+					for (size_t k = 0; k < std::min<size_t>(seq->size(), SEQ_SIZE); k++) encoded[k] = (uint8_t)fastareader::compression((*seq)[k]);
+				}
+				info.push_back({name + "_t", target.size()});
+				info.push_back({name + "_d", database.size()});
+				if (batch.size() == INPUT_SIZE) {
+					pack->add(batch, info);
+					batch = swaie::Batch();
+					info.clear();
+				}
+			} else if (cfg.format == "fasta") {
+				chunk += ">" + name + "_t\n" + target + "\n>" + name + "_d\n" + database + "\n";
+			} else {
+				chunk += "@" + name + "_t\n" + target + "\n+\n" + std::string(target.size(), 'I') + "\n";
+				chunk += "@" + name + "_d\n" + database + "\n+\n" + std::string(database.size(), 'I') + "\n";
+			}
+			if (chunk.size() >= (1 << 20)) {
+				text->write(chunk);
+				chunk.clear();
+			}
+		}
+
+		if (pack) {
+			if (batch.size() > 0) pack->add(batch, info);
+			pack->finish();
+		} else {
+			text->write(chunk);
+		}
+
+		std::cerr << "[SWGEN] " << cfg.pairs << " pairs (" << duplicates << " duplicates), seed " << cfg.seed
+			<< ", " << cfg.format << " -> " << cfg.out << std::endl;
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return 0;
+}
@@ -0,0 +1,171 @@
+/*
+MIT License
+
+Copyright (c) 2025 Carmine Pacilio
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <cstdlib>
+
+#include "../common/dataflow_model.h"
+#include "../common/golden.h"
+
+// Runs the software model of the device dataflow (common/dataflow_model.h)
+// to size streams and tile counts without the Vitis tools. Pairs are
+// random: the DP has a fixed size, so their content does not change the
+// timing, but the scores the model's host reads back are checked against
+// the golden model to catch ordering mistakes in the dataflow.
+
+static void usage(const char* argv0) {
+	std::cerr << "Usage: " << argv0 << " [--set <param>=<value>]... [--sweep <param>=<v1>,<v2>,...]" << std::endl;
+	std::cerr << "       [--seed <s>] [--no-verify] [--params]" << std::endl;
+	std::cerr << "  --params lists every parameter of the configuration and cost model with its default." << std::endl;
+}
+
+static bool parse_assignment(const std::string& arg, std::string& key, std::vector<double>& values) {
+	size_t eq = arg.find('=');
+	if (eq == std::string::npos || eq == 0) return false;
+	key = arg.substr(0, eq);
+	values.clear();
+	size_t begin = eq + 1;
+	for (;;) {
+		size_t comma = arg.find(',', begin);
+		std::string item = arg.substr(begin, comma == std::string::npos ? std::string::npos : comma - begin);
+		char* end = nullptr;
+		double v = std::strtod(item.c_str(), &end);
+		if (item.empty() || *end != '\0') return false;
+		values.push_back(v);
+		if (comma == std::string::npos) return true;
+		begin = comma + 1;
+	}
+}
+
+static swaie::Batch make_batch(size_t pairs, uint64_t seed) {
+	std::mt19937_64 rng(seed);
+	swaie::Batch batch;
+	for (size_t i = 0; i < pairs; i++) {
+		uint8_t* t = batch.target.append(SEQ_SIZE, 2 * i);
+		uint8_t* d = batch.database.append(SEQ_SIZE, 2 * i + 1);
+		for (size_t j = 0; j < SEQ_SIZE; j++) {
+			t[j] = rng() & 3;
+			d[j] = (rng() & 3) ? t[j] : (uint8_t)(rng() & 3);
+		}
+	}
+	return batch;
+}
+
+static size_t wrong_scores(const swaie::Batch& batch, const swaie::Scores& scores) {
+	size_t wrong = 0;
+	for (size_t i = 0; i < scores.size(); i++) {
+		if (scores[i] != swaie::compute_golden(batch.target[i], batch.database[i])) wrong++;
+	}
+	return wrong;
+}
+
+int main(int argc, char *argv[]) {
+
+	swaie::model::ModelConfig config;
+	std::string sweep_key;
+	std::vector<double> sweep_values;
+	uint64_t seed = 1;
+	bool verify = true, params = false;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--no-verify") { verify = false; continue; }
+		if (arg == "--params") { params = true; continue; }
+		if (i + 1 >= argc) { usage(argv[0]); return EXIT_FAILURE; }
+		std::string value = argv[++i];
+		std::string key;
+		std::vector<double> values;
+		if (arg == "--seed") seed = std::strtoull(value.c_str(), nullptr, 10);
+		else if (arg == "--set" && parse_assignment(value, key, values) && values.size() == 1) {
+			if (!swaie::model::set_parameter(config, key, values[0])) {
+				std::cerr << "[SWMODEL] Unknown parameter " << key << "; --params lists them." << std::endl;
+				return EXIT_FAILURE;
+			}
+		}
+		else if (arg == "--sweep" && parse_assignment(value, key, values)) {
+			swaie::model::ModelConfig probe;
+			if (!swaie::model::set_parameter(probe, key, values[0])) {
+				std::cerr << "[SWMODEL] Unknown parameter " << key << "; --params lists them." << std::endl;
+				return EXIT_FAILURE;
+			}
+			sweep_key = key;
+			sweep_values = values;
+		}
+		else { usage(argv[0]); return EXIT_FAILURE; }
+	}
+
+	if (params) {
+		swaie::model::print_parameters(std::cout, config);
+		return EXIT_SUCCESS;
+	}
+
+	try {
+		size_t pairs = config.pairs;
+		if (sweep_key == "pairs") pairs = (size_t)*std::max_element(sweep_values.begin(), sweep_values.end());
+		swaie::Batch batch = make_batch(pairs, seed);
+
+		if (sweep_key.empty()) {
+			swaie::model::ModelReport report = swaie::model::run_dataflow_model(config, batch);
+			swaie::model::print_report(std::cout, config, report);
+			if (verify && report.deadlock.empty()) {
+				size_t wrong = wrong_scores(batch, report.scores);
+				std::cout << "[SWMODEL] Scores: " << (wrong ? std::to_string(wrong) + " of " + std::to_string(report.scores.size()) + " wrong" : "match the golden model") << std::endl;
+				if (wrong) return EXIT_FAILURE;
+			}
+			return report.deadlock.empty() ? EXIT_SUCCESS : EXIT_FAILURE;
+		}
+
+		// One line per value; the full report is one --set away
+		bool failed = false;
+		for (double v : sweep_values) {
+			swaie::model::ModelConfig c = config;
+			swaie::model::set_parameter(c, sweep_key, v);
+			swaie::model::ModelReport report = swaie::model::run_dataflow_model(c, batch);
+
+			const swaie::model::StageStats* busiest = &report.stages.front();
+			for (const auto& s : report.stages) if (s.busy > busiest->busy) busiest = &s;
+			double seconds = report.seconds(c.cost);
+
+			std::cout << "[SWMODEL] " << sweep_key << "=" << v;
+			if (!report.deadlock.empty()) {
+				std::cout << "  deadlock: " << report.deadlock << std::endl;
+				failed = true;
+				continue;
+			}
+			size_t wrong = verify ? wrong_scores(batch, report.scores) : 0;
+			std::cout << "  cycles=" << (uint64_t)report.cycles << "  us=" << seconds * 1e6
+				<< "  Mpairs/s=" << c.pairs / seconds / 1e6 << "  busiest=" << busiest->name
+				<< (wrong ? "  WRONG SCORES=" + std::to_string(wrong) : "") << std::endl;
+			failed |= wrong > 0;
+		}
+		return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+	} catch (const std::exception& e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+}
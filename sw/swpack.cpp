@@ -0,0 +1,83 @@
+/*
+MIT License
+
+Copyright (c) 2025 Carmine Pacilio
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <chrono>
+
+#include "../common/packfile.h"
+
+// Converts FASTA/FASTQ (plain, gzip or BGZF; "-" for stdin) into a pack
+// file that host.exe and the library map straight into device buffers.
+
+static void usage(const char* argv0) {
+	std::cerr << "Usage: " << argv0 << " [--threads <n>] <input_file|-> <output.swpk>" << std::endl;
+	std::cerr << "       " << argv0 << " --info <file.swpk>" << std::endl;
+}
+
+int main(int argc, char *argv[]) {
+
+	swaie::ReaderOptions options;
+	options.keep_names = true;
+	std::string info_file;
+	std::vector<std::string> files;
+
+	for (int i = 1; i < argc; i++) {
+		std::string arg = argv[i];
+		if (arg == "--threads" && i + 1 < argc) options.threads = std::atoi(argv[++i]);
+		else if (arg == "--info" && i + 1 < argc) info_file = argv[++i];
+		else if (arg[0] != '-' || arg == "-") files.push_back(arg);
+		else { usage(argv[0]); return EXIT_FAILURE; }
+	}
+
+	try {
+		if (!info_file.empty()) {
+			swaie::PackFile pack(info_file);
+			std::cout << "[SWPACK] " << info_file << ": " << pack.size() << " pairs in " << pack.runs() << " runs of "
+				<< INPUT_SIZE << ", " << NUM_INPUT_PORTS << " ports x " << pack.port_bytes() << " bytes per run" << std::endl;
+			if (pack.size() > 0) {
+				std::cout << "[SWPACK] first pair: " << pack.target_name(0) << " (" << pack.entry(0).target_len << " bp) vs "
+					<< pack.database_name(0) << " (" << pack.entry(0).database_len << " bp)" << std::endl;
+			}
+			return 0;
+		}
+
+		if (files.size() != 2) { usage(argv[0]); return EXIT_FAILURE; }
+
+		auto start = std::chrono::high_resolution_clock::now();
+		swaie::SequenceReader reader(files[0], options);
+		size_t pairs = swaie::write_packfile(files[1], reader);
+		auto stop = std::chrono::high_resolution_clock::now();
+
+		auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(stop - start);
+		std::cout << "[SWPACK] Packed " << pairs << " pairs (" << reader.format() << ") into " << files[1]
+			<< " in " << duration.count() << " ms" << std::endl;
+	} catch (const std::exception &e) {
+		std::cerr << e.what() << std::endl;
+		return EXIT_FAILURE;
+	}
+
+	return 0;
+}
@@ -0,0 +1,128 @@
+/*
+MIT License
+
+Copyright (c) 2025 Carmine Pacilio
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+#include "../../common/fastareader.h"
+#include "../../common/golden.h"
+#include "../../common/packer.h"
+#include "../../common/seqreader.h"
+
+// Short records read with the default fixed-length padding, and short views
+// packed for the device, must score like the unpadded pair: pads of the two
+// sides never match each other.
+
+using namespace swaie;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+	if (!ok) {
+		std::cerr << "[SWAIE TESTBENCH] FAIL: " << what << std::endl;
+		failures++;
+	}
+}
+
+static std::vector<uint8_t> encode(const std::string& bases) {
+	std::vector<uint8_t> codes;
+	for (char c : bases) codes.push_back((uint8_t)(unsigned)fastareader::compression(c));
+	return codes;
+}
+
+static int golden(const std::vector<uint8_t>& target, const std::vector<uint8_t>& database) {
+	return compute_golden(SequenceView(target.data(), target.size()), SequenceView(database.data(), database.size()));
+}
+
+int main() {
+	std::cout << "[SWAIE TESTBENCH] Starting padding tests." << std::endl;
+
+	std::vector<std::pair<std::string, std::string>> pairs = {
+		{std::string(100, 'A'), std::string(100, 'C')},
+		{std::string(100, 'A'), std::string(100, 'A')},
+		{std::string(SEQ_SIZE, 'G'), std::string(1, 'T')},
+		{std::string(1, 'T'), std::string(SEQ_SIZE, 'G')},
+	};
+	std::mt19937 rng(31);
+	for (int n = 0; n < 200; n++) {
+		std::string target, database;
+		size_t t_len = 1 + rng() % SEQ_SIZE, d_len = 1 + rng() % SEQ_SIZE;
+		for (size_t i = 0; i < t_len; i++) target += "ACGTN"[rng() % 5];
+		for (size_t i = 0; i < d_len; i++) database += "ACGTN"[rng() % 5];
+		pairs.push_back({target, database});
+	}
+
+	char path[] = "/tmp/swaie_padding_XXXXXX";
+	int fd = ::mkstemp(path);
+	if (fd < 0) {
+		std::cerr << "[SWAIE TESTBENCH] Cannot create a temporary file." << std::endl;
+		return EXIT_FAILURE;
+	}
+	::close(fd);
+	{
+		std::ofstream fasta(path);
+		for (size_t n = 0; n < pairs.size(); n++) {
+			fasta << ">t" << n << "\n" << pairs[n].first << "\n>d" << n << "\n" << pairs[n].second << "\n";
+		}
+	}
+
+	Batch batch;
+	{
+		SequenceReader reader(path);
+		reader.read_pairs(batch, pairs.size());
+	}
+	std::remove(path);
+	check(batch.size() == pairs.size(), "read " + std::to_string(batch.size()) + " of " + std::to_string(pairs.size()) + " pairs");
+
+	check(compute_golden(batch.target[0], batch.database[0]) == 0, "100 A against 100 C does not score 0");
+	check(compute_golden(batch.target[1], batch.database[1]) == 100, "100 A against 100 A does not score 100");
+
+	std::vector<input_t> couple(COUPLE_WORDS);
+	std::vector<uint8_t> target(UNPACKED_LENGTH), database(UNPACKED_LENGTH);
+	for (size_t n = 0; n < batch.size() && n < pairs.size(); n++) {
+		std::vector<uint8_t> t = encode(pairs[n].first), d = encode(pairs[n].second);
+		int want = golden(t, d);
+		check(batch.target[n].size() == UNPACKED_LENGTH && batch.database[n].size() == UNPACKED_LENGTH,
+			"pair " + std::to_string(n) + " is not padded to SEQ_SIZE + 2");
+		check(compute_golden(batch.target[n], batch.database[n]) == want,
+			"read pair " + std::to_string(n) + " scores differently once padded");
+
+		pack_couple(SequenceView(t.data(), t.size()), SequenceView(d.data(), d.size()), couple.data());
+		unpack_couple(couple.data(), target.data(), database.data());
+		check(golden(target, database) == want, "packed pair " + std::to_string(n) + " scores differently once padded");
+	}
+
+	if (failures) {
+		std::cerr << "[SWAIE TESTBENCH] " << failures << " padding checks failed." << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::cout << "[SWAIE TESTBENCH] " << pairs.size() << " short pairs keep their score once padded." << std::endl;
+	return EXIT_SUCCESS;
+}
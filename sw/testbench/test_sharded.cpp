@@ -0,0 +1,154 @@
+/*
+MIT License
+
+Copyright (c) 2025 Carmine Pacilio
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "../../common/sharded.h"
+
+// Mock shards at unequal rates behind the sharded backend: scores come back
+// in input order, every pair goes to exactly one shard once, and a shard's
+// error reaches the caller.
+
+using namespace swaie;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+	if (!ok) {
+		std::cerr << "[SWAIE TESTBENCH] FAIL: " << what << std::endl;
+		failures++;
+	}
+}
+
+// Counts, by sequence id, the pairs handed to the backend it wraps
+class CountingBackend : public Backend {
+public:
+	CountingBackend(std::unique_ptr<Backend> inner, std::vector<std::atomic<int>>& seen)
+		: inner_(std::move(inner)), seen_(seen) {}
+
+	std::string name() const override { return inner_->name(); }
+	size_t preferred_batch() const override { return inner_->preferred_batch(); }
+
+	Scores align(const Batch& batch) override {
+		for (size_t i = 0; i < batch.size(); i++) seen_[batch.target.id(i)]++;
+		pairs += batch.size();
+		return inner_->align(batch);
+	}
+
+	size_t pairs = 0;
+
+private:
+	std::unique_ptr<Backend> inner_;
+	std::vector<std::atomic<int>>& seen_;
+};
+
+class FailingBackend : public Backend {
+public:
+	std::string name() const override { return "failing"; }
+
+	Scores align(const Batch&) override {
+		throw std::runtime_error("[TESTBENCH] shard failed");
+	}
+};
+
+static Batch random_batch(size_t pairs, std::mt19937& rng) {
+	Batch batch;
+	std::vector<uint8_t> target(SEQ_SIZE), database(SEQ_SIZE);
+	for (size_t n = 0; n < pairs; n++) {
+		for (uint8_t& b : target) b = rng() % 4;
+		for (uint8_t& b : database) b = rng() % 4;
+		batch.target.push_back(SequenceView(target.data(), target.size()));
+		batch.database.push_back(SequenceView(database.data(), database.size()));
+	}
+	return batch;
+}
+
+int main() {
+	std::cout << "[SWAIE TESTBENCH] Starting sharded backend tests." << std::endl;
+	std::mt19937 rng(38);
+
+	const size_t pairs = 20000;
+	Batch batch = random_batch(pairs, rng);
+	std::vector<std::atomic<int>> seen(pairs);
+
+	const double rates[] = {4e6, 1e6, 2e5};
+	const size_t preferred[] = {0, 256, 1000};
+	std::vector<CountingBackend*> counters;
+	std::vector<std::unique_ptr<Backend>> shards;
+	for (int s = 0; s < 3; s++) {
+		auto shard = std::make_unique<CountingBackend>(
+			make_mock_backend("mock" + std::to_string(s), rates[s], preferred[s]), seen);
+		counters.push_back(shard.get());
+		shards.push_back(std::move(shard));
+	}
+	std::unique_ptr<Backend> sharded = make_sharded_backend(std::move(shards), 512);
+
+	for (int round = 0; round < 2; round++) {
+		for (std::atomic<int>& s : seen) s = 0;
+		Scores scores = sharded->align(batch);
+		check(scores.size() == pairs, "got " + std::to_string(scores.size()) + " scores for " + std::to_string(pairs) + " pairs");
+
+		size_t misplaced = 0, repeated = 0;
+		for (size_t i = 0; i < pairs && i < scores.size(); i++) {
+			misplaced += scores[i] != mock_score(batch.target[i], batch.database[i]);
+			repeated += seen[i] != 1;
+		}
+		check(misplaced == 0, std::to_string(misplaced) + " scores out of input order");
+		check(repeated == 0, std::to_string(repeated) + " pairs not scored exactly once");
+	}
+	for (CountingBackend* c : counters) {
+		check(c->pairs > 0, c->name() + " never got a chunk");
+	}
+	check(counters[0]->pairs > counters[2]->pairs, "the fastest shard did not outwork the slowest");
+
+	Scores tiny = sharded->align(batch.slice(0, 3));
+	check(tiny.size() == 3 && tiny[2] == mock_score(batch.target[2], batch.database[2]), "a 3-pair batch is not scored");
+
+	std::vector<std::unique_ptr<Backend>> failing;
+	failing.push_back(make_mock_backend("mock", 1e5));
+	failing.push_back(std::make_unique<FailingBackend>());
+	std::unique_ptr<Backend> broken = make_sharded_backend(std::move(failing), 64);
+	bool raised = false;
+	try {
+		broken->align(batch.slice(0, 4096));
+	} catch (const std::runtime_error& e) {
+		raised = std::string(e.what()) == "[TESTBENCH] shard failed";
+	}
+	check(raised, "a shard's error did not reach the caller");
+
+	if (failures) {
+		std::cerr << "[SWAIE TESTBENCH] " << failures << " sharded backend checks failed." << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::cout << "[SWAIE TESTBENCH] " << pairs << " pairs over 3 mock shards scored once each, in order; shards split them "
+		<< counters[0]->pairs << "/" << counters[1]->pairs << "/" << counters[2]->pairs << "." << std::endl;
+	return EXIT_SUCCESS;
+}
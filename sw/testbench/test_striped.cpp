@@ -0,0 +1,135 @@
+/*
+MIT License
+
+Copyright (c) 2025 Carmine Pacilio
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+*/
+
+#include <iostream>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+#include "../../common/cpu_kernels.h"
+#include "../../common/golden.h"
+
+// align_striped against compute_golden on pairs whose best score lands on
+// both sides of where the 8-bit pass saturates and the 16-bit one takes
+// over, with N and pad codes in the mix, up to 10 kb.
+
+using namespace swaie;
+
+static int failures = 0;
+
+static void check(bool ok, const std::string& what) {
+	if (!ok) {
+		std::cerr << "[SWAIE TESTBENCH] FAIL: " << what << std::endl;
+		failures++;
+	}
+}
+
+static std::mt19937_64 rng(48);
+
+static std::vector<uint8_t> random_bases(size_t length) {
+	const uint8_t codes[] = {0, 1, 2, 3, 0, 1, 2, 3, 0, 1, 2, 3, 0, TARGET_PAD, DATABASE_PAD, 15};
+	std::vector<uint8_t> bases(length);
+	for (uint8_t& b : bases) b = codes[rng() & 15];
+	return bases;
+}
+
+// Copy of bases with each one replaced by a random base with probability 1 - identity
+static std::vector<uint8_t> mutate(const std::vector<uint8_t>& bases, double identity) {
+	std::vector<uint8_t> copy = bases;
+	std::uniform_real_distribution<double> uniform(0, 1);
+	for (uint8_t& b : copy) {
+		if (uniform(rng) >= identity) b = rng() & 3;
+	}
+	return copy;
+}
+
+static void compare(const std::vector<uint8_t>& target, const std::vector<uint8_t>& database, const std::string& what) {
+	SequenceView t(target.data(), target.size()), d(database.data(), database.size());
+	size_t longest = std::max(target.size(), database.size());
+	int32_t want = compute_golden(t, d, longest);
+	int32_t got = align_striped(t, d, longest);
+	check(got == want, what + ": striped " + std::to_string(got) + ", golden " + std::to_string(want));
+	// The same pair cut to its first SEQ_SIZE bases, as the short-read engines see it
+	check(align_striped(t, d, SEQ_SIZE) == compute_golden(t, d, SEQ_SIZE), what + ": differs cut to SEQ_SIZE");
+}
+
+int main() {
+	std::cout << "[SWAIE TESTBENCH] Starting striped kernel tests." << std::endl;
+	size_t pairs = 0;
+
+	// A shared run of run bases in unrelated flanks scores about run: runs
+	// from well below UINT8_MAX to past it
+	for (size_t run = 200; run <= 320; run += 5) {
+		std::vector<uint8_t> shared = random_bases(run);
+		std::vector<uint8_t> target = random_bases(rng() % 64), database = random_bases(rng() % 64);
+		target.insert(target.end(), shared.begin(), shared.end());
+		database.insert(database.end(), shared.begin(), shared.end());
+		std::vector<uint8_t> t_tail = random_bases(rng() % 64), d_tail = random_bases(rng() % 64);
+		target.insert(target.end(), t_tail.begin(), t_tail.end());
+		database.insert(database.end(), d_tail.begin(), d_tail.end());
+		compare(target, database, "shared run of " + std::to_string(run));
+		pairs++;
+	}
+
+	const size_t lengths[] = {1, 15, 16, 17, 150, 250, 254, 255, 256, 257, 270, 300, 511, 512, 1000, 3000, 10000};
+	const double identities[] = {0.25, 0.8, 0.95, 1.0};
+	for (size_t length : lengths) {
+		for (double identity : identities) {
+			std::vector<uint8_t> target = random_bases(length);
+			compare(target, mutate(target, identity), std::to_string(length) + " bases at identity " + std::to_string(identity));
+			// Unequal lengths, both ways round
+			std::vector<uint8_t> shorter = mutate(target, identity);
+			shorter.resize(length / 2 + 1);
+			compare(target, shorter, std::to_string(length) + " against " + std::to_string(shorter.size()) + " bases");
+			compare(shorter, target, std::to_string(shorter.size()) + " against " + std::to_string(length) + " bases");
+			pairs += 3;
+		}
+	}
+
+	// At the 16-bit limit an identical pair scores its length; one base more throws
+	std::vector<uint8_t> longest = random_bases(STRIPED_MAX_LENGTH);
+	for (uint8_t& b : longest) b &= 3;
+	SequenceView view(longest.data(), longest.size());
+	check(align_striped(view, view, view.size()) == (int32_t)STRIPED_MAX_LENGTH * MATCH, "identical pair at STRIPED_MAX_LENGTH");
+	longest.push_back(0);
+	bool raised = false;
+	try {
+		view = SequenceView(longest.data(), longest.size());
+		align_striped(view, view, view.size());
+	} catch (const std::runtime_error&) {
+		raised = true;
+	}
+	check(raised, "a pair past STRIPED_MAX_LENGTH does not throw");
+	pairs++;
+
+	if (failures) {
+		std::cerr << "[SWAIE TESTBENCH] " << failures << " striped kernel checks failed." << std::endl;
+		return EXIT_FAILURE;
+	}
+	std::cout << "[SWAIE TESTBENCH] " << pairs << " pairs match compute_golden on both sides of 8-bit saturation." << std::endl;
+	return EXIT_SUCCESS;
+}
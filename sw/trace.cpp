@@ -0,0 +1,206 @@
+/******************************************
+*MIT License
+*
+# *Copyright (c) Carmine Pacilio [2025]
+*
+*Permission is hereby granted, free of charge, to any person obtaining a copy
+*of this software and associated documentation files (the "Software"), to deal
+*in the Software without restriction, including without limitation the rights
+*to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+*copies of the Software, and to permit persons to whom the Software is
+*furnished to do so, subject to the following conditions:
+*
+*The above copyright notice and this permission notice shall be included in all
+*copies or substantial portions of the Software.
+*
+*THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+*IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+*FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+*AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+*LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+*OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+*SOFTWARE.
+******************************************/
+
+#include "../common/trace.h"
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace swaie {
+namespace trace {
+
+    std::atomic<bool> active{false};
+
+    struct Event {
+        const char* name;
+        uint64_t start_ns;
+        uint64_t end_ns;
+        uint64_t cells;
+    };
+
+    struct Ring {
+        int tid;
+        std::string thread_name;
+        std::vector<Event> events;
+        // Events written so far; the writer publishes each one with a release store
+        std::atomic<uint64_t> head{0};
+    };
+
+    // Rings are never freed, only handed to the next thread once their owner
+    // exits, so short-lived worker threads do not grow the registry
+    static std::mutex registry_mutex;
+    static std::vector<std::unique_ptr<Ring>> registry;
+    static std::vector<Ring*> free_rings;
+    static size_t ring_events = 1 << 14;
+
+    static const auto epoch = std::chrono::steady_clock::now();
+
+    struct RingHandle {
+        Ring* ring = nullptr;
+
+        ~RingHandle() {
+            if (!ring) return;
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            free_rings.push_back(ring);
+        }
+    };
+
+    static thread_local RingHandle handle;
+
+    static Ring* thread_ring() {
+        if (handle.ring) return handle.ring;
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        if (!free_rings.empty()) {
+            handle.ring = free_rings.back();
+            free_rings.pop_back();
+        } else {
+            registry.push_back(std::make_unique<Ring>());
+            handle.ring = registry.back().get();
+            handle.ring->tid = (int)registry.size();
+            handle.ring->thread_name = "thread " + std::to_string(registry.size());
+            handle.ring->events.resize(ring_events);
+        }
+        return handle.ring;
+    }
+
+    void enable(size_t events_per_thread) {
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            if (registry.empty()) ring_events = std::max<size_t>(events_per_thread, 1);
+        }
+        active.store(true, std::memory_order_relaxed);
+    }
+
+    void set_thread_name(const std::string& name) {
+        if (!enabled()) return;
+        Ring* ring = thread_ring();
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        ring->thread_name = name;
+    }
+
+    uint64_t now_ns() {
+        // +1 keeps a valid timestamp from ever reading as "not started"
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count() + 1;
+    }
+
+    void record(const char* name, uint64_t start_ns, uint64_t end_ns, uint64_t cells) {
+        Ring* ring = thread_ring();
+        uint64_t h = ring->head.load(std::memory_order_relaxed);
+        ring->events[h % ring->events.size()] = {name, start_ns, end_ns, cells};
+        ring->head.store(h + 1, std::memory_order_release);
+    }
+
+    // Oldest to newest events still held by a ring
+    static std::vector<Event> snapshot(const Ring& ring) {
+        uint64_t h = ring.head.load(std::memory_order_acquire);
+        uint64_t n = std::min<uint64_t>(h, ring.events.size());
+        std::vector<Event> out;
+        out.reserve(n);
+        for (uint64_t i = h - n; i < h; i++) out.push_back(ring.events[i % ring.events.size()]);
+        return out;
+    }
+
+    static std::string json_escape(const std::string& s) {
+        std::string out;
+        for (char c : s) {
+            if (c == '"' || c == '\\') out.push_back('\\');
+            out.push_back(c);
+        }
+        return out;
+    }
+
+    bool write_chrome_json(const std::string& path) {
+        std::ofstream file(path);
+        if (!file) return false;
+
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[" << std::fixed << std::setprecision(3);
+        bool first = true;
+        for (const auto& ring : registry) {
+            file << (first ? "" : ",") << "\n{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << ring->tid
+                << ",\"args\":{\"name\":\"" << json_escape(ring->thread_name) << "\"}}";
+            first = false;
+            for (const Event& e : snapshot(*ring)) {
+                file << ",\n{\"ph\":\"X\",\"name\":\"" << json_escape(e.name) << "\",\"pid\":1,\"tid\":" << ring->tid
+                    << ",\"ts\":" << e.start_ns / 1e3 << ",\"dur\":" << (e.end_ns - e.start_ns) / 1e3;
+                if (e.cells) file << ",\"args\":{\"cells\":" << e.cells << "}";
+                file << "}";
+            }
+        }
+        file << "\n]}\n";
+        return (bool)file;
+    }
+
+    void print_summary(std::ostream& os) {
+        struct Phase {
+            uint64_t count = 0;
+            uint64_t total_ns = 0;
+            uint64_t max_ns = 0;
+            uint64_t cells = 0;
+        };
+        std::map<std::string, Phase> phases;
+        uint64_t begin = UINT64_MAX, end = 0;
+
+        {
+            std::lock_guard<std::mutex> lock(registry_mutex);
+            for (const auto& ring : registry) {
+                for (const Event& e : snapshot(*ring)) {
+                    Phase& p = phases[e.name];
+                    uint64_t ns = e.end_ns - e.start_ns;
+                    p.count++;
+                    p.total_ns += ns;
+                    p.max_ns = std::max(p.max_ns, ns);
+                    p.cells += e.cells;
+                    begin = std::min(begin, e.start_ns);
+                    end = std::max(end, e.end_ns);
+                }
+            }
+        }
+        if (phases.empty()) return;
+
+        std::ios state(nullptr);
+        state.copyfmt(os);
+        double wall = end - begin;
+        os << std::fixed << "[TRACE] " << phases.size() << " phases over " << std::setprecision(3) << wall * 1e-6 << " ms wall" << std::endl;
+        os << "[TRACE] phase              count    total ms     mean us      max us   % wall    GCUPS" << std::endl;
+        for (const auto& entry : phases) {
+            const Phase& p = entry.second;
+            os << "[TRACE] " << std::left << std::setw(16) << entry.first << std::right << std::setw(9) << p.count
+                << std::setprecision(3) << std::setw(12) << p.total_ns * 1e-6 << std::setw(12) << p.total_ns * 1e-3 / p.count
+                << std::setw(12) << p.max_ns * 1e-3 << std::setprecision(1) << std::setw(9) << 100.0 * p.total_ns / wall;
+            // Cells per nanosecond of phase time: the throughput of that phase alone
+            if (p.cells) os << std::setprecision(3) << std::setw(9) << (double)p.cells / p.total_ns;
+            os << std::endl;
+        }
+        os.copyfmt(state);
+    }
+
+} // namespace trace
+} // namespace swaie